@@ -9,6 +9,7 @@
 #include <mutex>
 #include <algorithm>
 #include <map>
+#include <list>
 #include <memory>
 #include <imgui_json.h>
 //#include <variant.hpp>  // variant for C++14
@@ -28,16 +29,19 @@
 #define BP_ERR_PIN_LINK     -6
 #define BP_ERR_DOC_LOAD     -7
 #define BP_ERR_GROUP_LOAD   -8
+#define BP_ERR_PIN_TYPE     -9
 
 typedef uint32_t ID_TYPE;
 typedef uint32_t VERSION_TYPE;
 
 // for C++14
 //using nonstd::get;
+//using nonstd::get_if;
 //using nonstd::monostate;
 //using nonstd::variant;
 // for C++17
 using std::get;
+using std::get_if;
 using std::monostate;
 using std::variant;
 using nonstd::span;
@@ -49,7 +53,31 @@ using std::make_unique;
 using std::shared_ptr;
 using std::unique_ptr;
 
+namespace BluePrint
+{
+# pragma region IDMap
+// Flat old->new ID remap table, fill with Set(), call Build() once and then share it read-only (by const reference)
+struct IMGUI_API IDMap
+{
+    void Reserve(size_t size);
+    void Set(ID_TYPE from, ID_TYPE to);
+    void Build();                       // Sort entries, the last Set() of a duplicated ID wins
+    void Clear();
+
+    ID_TYPE Get(ID_TYPE from) const;    // Returns 0 if ID isn't in map
+    bool Contains(ID_TYPE from) const;
+    bool Empty() const { return m_Entries.empty(); }
+    size_t Size() const { return m_Entries.size(); }
+
+private:
+    std::vector<std::pair<ID_TYPE, ID_TYPE>> m_Entries;
+    bool m_Sorted {true};
+};
+# pragma endregion
+} // namespace BluePrint
+
 #include "Pin.h"
+#include "Expression.h"
 
 #define OFFSET_32 0x811c9dc5
 #define OFFSET_64 0xcbf29ce484222325
@@ -73,6 +101,18 @@ inline uint64_t fnv1a_hash_64(string str)
     return hash;
 }
 
+inline uint64_t fnv1a_hash_64(const void* data, size_t size, uint64_t hash = OFFSET_64)
+{
+    // incremental version, pass previous result as hash to continue
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = hash ^ bytes[i];
+        hash = hash * PRIME_64;
+    }
+    return hash;
+}
+
 inline uint32_t fnv1a_hash_32(string str) 
 {
     uint32_t prime = PRIME_32;
@@ -90,6 +130,7 @@ inline uint32_t fnv1a_hash_32(string str)
 struct NodeRegistry;
 struct Node;
 struct Context;
+struct ExprProgram;
 enum class StepResult
 {
     Success,
@@ -101,6 +142,7 @@ enum class StepResult
 struct IDGenerator
 {
     ID_TYPE GenerateID();
+    ID_TYPE GenerateIDRange(ID_TYPE count); // reserve count consecutive IDs, returns the first one
 
     void SetState(ID_TYPE state);
     ID_TYPE State() const;
@@ -167,6 +209,9 @@ struct IMGUI_API Context
 
     void SetPinValue(const Pin& pin, PinValue value);
     PinValue GetPinValue(const Pin& pin, bool threading = false) const;
+    // Borrow the value stored for pin (or the output it is linked to) without copying or evaluating it.
+    // Returns nullptr when no value is stored yet, the pointer is valid until the next SetPinValue/Reset.
+    const PinValue* GetPinValueRef(const Pin& pin) const;
 
     StepResult SetStepResult(StepResult result);
 
@@ -192,6 +237,7 @@ struct IMGUI_API Context
     FlowPin                         m_PrevFlowPin = {};
     StepResult                      m_LastResult {StepResult::Done};
     uint32_t                        m_StepCount {0};
+    uint32_t                        m_ResetEpoch {1};   // bumped by ResetState, nodes reset lazily when their epoch differs
     std::map<uint32_t, PinValue>    m_Values;
     std::thread*                    m_thread {nullptr};
 };
@@ -284,6 +330,34 @@ public:
 # pragma endregion
 
 # pragma region BP
+// Linked input whose value type the receiving node cannot take, reported by BP::InferTypes
+struct TypeMismatch
+{
+    ID_TYPE m_Receiver {0};
+    ID_TYPE m_Provider {0};
+    PinType m_Expected {PinType::Void};
+    PinType m_Actual {PinType::Void};
+};
+
+// Inputs a node was looked up with in the output cache. On a miss they are handed to Execute as
+// context values of the input pins, so nothing upstream is evaluated twice, and the stored entry
+// keeps them to compare the next lookup against.
+struct OutputCacheProbe
+{
+    uint64_t                    m_Key {0};      // 0 when the node is not cacheable
+    std::vector<PinValue>       m_Inputs;       // data input values in pin order
+    std::vector<const Pin*>     m_Seeded;       // input pins given a context value for Execute
+};
+
+struct OutputCacheStats
+{
+    uint64_t    m_Hits {0};
+    uint64_t    m_Misses {0};
+    uint64_t    m_Evictions {0};
+    size_t      m_Bytes {0};
+    size_t      m_Entries {0};
+};
+
 struct IMGUI_API BP
 {
     BP();
@@ -369,8 +443,61 @@ struct IMGUI_API BP
     int Load(std::string path);
     bool Save(std::string path) const;
 
+    void SetLazyPreLoad(bool lazy) { m_LazyPreLoad = lazy; } // Defer node PreLoad until the context first reaches the node
+    bool IsLazyPreLoad() const { return m_LazyPreLoad; }
+    void Prefetch(Node& entryPointNode); // Warm deferred nodes reachable from entry point in background, breadth-first, any graph edit stops it
+
+    int  InferTypes();  // Resolve Any pin types over the whole graph and validate every link, BP_ERR_PIN_TYPE on mismatch
+    bool IsTypeVerified() const { return m_TypeVerified; } // Graph passed InferTypes and has not been relinked since
+    void InvalidateTypes() { m_TypeVerified = false; }
+    void OnLinkChanged();   // Called before a link changes, stops prefetch and drops link derived state: type verification and the constant folding plan
+    const std::vector<TypeMismatch>& GetTypeMismatches() const { return m_TypeMismatches; }
+    bool IsLoading() const { return m_Loading; }
+
+    // Cache outputs of pure nodes whose inputs are all constant nodes or unlinked pins, recomputed
+    // only when one of those inputs changes. The graph itself is left untouched.
+    void SetConstantFolding(bool enable);
+    bool IsConstantFolding() const { return m_ConstantFolding; }
+    bool GetFoldedValue(const Context& context, const Pin& pin, PinValue& value, bool threading = false); // Used by Context::GetPinValue
+
+    // Run pure scalar regions (nodes with NODE_CAPS_EXPR) as compiled bytecode, programs are kept per
+    // output pin until the next link change
+    void SetExprCompile(bool enable);
+    bool IsExprCompile() const { return m_ExprCompile; }
+    bool GetCompiledValue(const Context& context, const Pin& pin, PinValue& value, bool threading = false); // Used by Context::GetPinValue
+
+    // Incremental runs re-execute only nodes that changed since the previous run, or read from one that
+    // did. Clean nodes keep their outputs and continue at the exit they took last time. Nodes with more
+    // than one flow input or output, and volatile nodes, always execute. Entry values are compared by
+    // value, except mats, arrays and custom payloads which count as changed on every run.
+    void SetIncremental(bool enable);
+    bool IsIncremental() const { return m_Incremental; }
+    // Node settings and unlinked pin values are not compared, the editor calls MarkNodeDirty when it
+    // changes them. A host changing them any other way must call it too, or incremental runs and the
+    // output cache keep returning outputs computed from the old values.
+    void MarkNodeDirty(Node& node); // parameter or setting of node changed, dirties everything reading from it
+    bool ReuseNodeResult(const Node& node, FlowPin& next);          // Used by Context::Step
+    void RecordNodeResult(Node& node, const FlowPin& next);         // Used by Context::Step
+
+    // Keep outputs of straight nodes together with the inputs they came from, so a node that sees the same
+    // inputs again (paused or scrubbed playback) restores them instead of executing. Inputs are compared
+    // with PinValue::SameAs, entries hold them alive so a buffer cannot be recycled under the same address,
+    // a host writing a new frame in place into a buffer it handed in before must ClearOutputCache. Time
+    // dependent nodes (NODE_CAPS_TIME) add the timestamp to the key, volatile nodes are never cached.
+    // Least recently used entries are dropped once the values kept alive exceed budget bytes.
+    void SetOutputCache(bool enable, size_t budget = 256 * 1024 * 1024);
+    bool IsOutputCache() const { return m_OutputCache; }
+    void ClearOutputCache();
+    OutputCacheStats GetOutputCacheStats() const;
+    bool LookupCachedOutputs(Context& context, Node& node, FlowPin& next, OutputCacheProbe& probe, bool threading = false); // Used by Context::Step
+    void StoreCachedOutputs(Context& context, Node& node, OutputCacheProbe&& probe, const FlowPin& next);                   // Used by Context::Step
+
+    static uint64_t ContentHash(const imgui_json::value& value);    // Canonical hash of node types/versions, links and pin values
+    static void SetLoadCache(bool enable, size_t capacity = 256); // Cache loaded, type resolved graphs in memory for Load(path), keyed by ContentHash
+
     ID_TYPE MakeNodeID(Node* node);
     ID_TYPE MakePinID(Pin* pin);
+    ID_TYPE MakeIDRange(ID_TYPE count);
 
     bool HasPinAnyLink(const Pin& pin) const;
 
@@ -394,7 +521,23 @@ struct IMGUI_API BP
 
 private:
     void ResetState();
+    void StopPrefetch();
+    int  Load(const imgui_json::value& value, bool typesResolved);
     Node * CreateDummyNode(const imgui_json::value& value, BP* blueprint);
+    void BuildFoldPlan();
+    void UpdateEntryFingerprint(Node& entryPointNode);
+    void DropNodeResults();
+    void MarkDirtyFrom(std::vector<const Node*> dirty);
+    bool IsReplayable(Node& node) const;
+    void BuildReaders();
+
+    struct FoldEntry
+    {
+        std::vector<const Pin*> m_Leaves;           // constant node outputs and unlinked inputs feeding the pin
+        std::vector<PinValue>   m_LeafValues;       // leaf values m_Value was computed from, kept alive for SameAs
+        bool                    m_Valid {false};
+        PinValue                m_Value;
+    };
 
     static shared_ptr<NodeRegistry>        s_NodeRegistry;
     static shared_ptr<PinExRegistry>       s_PinExRegistry;
@@ -404,6 +547,52 @@ private:
     Context                         m_Context;
     bool                            m_StyleLight {false};
     bool                            m_IsOpen {false};
+    bool                            m_LazyPreLoad {false};
+    std::thread*                    m_PrefetchThread {nullptr};
+    std::atomic<bool>               m_PrefetchCancel {false};
+    bool                            m_Loading {false};
+    bool                            m_TypeVerified {false};
+    std::vector<TypeMismatch>       m_TypeMismatches;
+    bool                            m_ConstantFolding {true};
+    bool                            m_FoldsDirty {true};
+    std::unordered_map<ID_TYPE, std::shared_ptr<FoldEntry>> m_Folds; // shared so a rebuild never frees an entry in use
+    std::mutex                      m_FoldMutex;
+    bool                            m_ExprCompile {true};
+    std::unordered_map<ID_TYPE, std::shared_ptr<const ExprProgram>> m_Programs; // nullptr when the pin cannot be compiled
+    std::mutex                      m_ProgramMutex;
+    struct NodeResult
+    {
+        FlowPin                     m_Exit;         // exit the node took when it last executed
+        uint32_t                    m_Run {0};      // run that execution happened in
+    };
+
+    bool                            m_Incremental {false};
+    std::unordered_map<const Node*, NodeResult> m_NodeResults;  // clean nodes
+    std::unordered_map<const Node*, std::vector<const Node*>> m_Readers; // data link readers of each node, built on demand
+    std::vector<const Node*>        m_AlwaysDirty;  // nodes whose outputs may change on every run
+    mutable std::unordered_map<const Node*, bool> m_Replayable; // IsReplayable answers until the graph changes
+    mutable std::mutex              m_ReplayableMutex;
+    bool                            m_ReadersValid {false};
+    uint64_t                        m_EntryFingerprint {0};
+    uint32_t                        m_Run {0};
+    std::mutex                      m_ResultMutex;
+    struct CachedOutputs
+    {
+        uint64_t                    m_Key {0};
+        const Node*                 m_Node {nullptr};
+        std::vector<PinValue>       m_Inputs;       // compared with SameAs on lookup, the key is only a hash
+        std::vector<std::pair<const Pin*, PinValue>> m_Values;
+        FlowPin                     m_Exit;
+        size_t                      m_Bytes {0};
+    };
+
+    bool                            m_OutputCache {false};
+    size_t                          m_CacheBudget {0};
+    std::list<CachedOutputs>        m_CacheEntries;     // most recently used first
+    std::unordered_map<uint64_t, std::list<CachedOutputs>::iterator> m_CacheIndex;
+    std::unordered_map<const Node*, uint32_t> m_NodeEdits;  // bumped by MarkNodeDirty, part of the key
+    OutputCacheStats                m_CacheStats;
+    mutable std::mutex              m_CacheMutex;
 
     // Node Time info
     int64_t                         m_TimeStamp {-1};
@@ -428,7 +617,7 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
 # define BP_NODE(type, node_version, api_version, node_type, node_style, node_catalog) \
     static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
     { \
-        return \
+        ::BluePrint::NodeTypeInfo info \
         { \
             fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -442,6 +631,8 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        info.m_Caps = ::BluePrint::NodeCapsOf<type>(); \
+        return info; \
     } \
     \
     ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
@@ -452,7 +643,7 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
 # define BP_NODE_WITH_NAME(type, name, author, node_version, api_version, node_type, node_style, node_catalog) \
     static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
     { \
-        return \
+        ::BluePrint::NodeTypeInfo info \
         { \
             fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -466,6 +657,8 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        info.m_Caps = ::BluePrint::NodeCapsOf<type>(); \
+        return info; \
     } \
     \
     ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
@@ -488,7 +681,7 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
     } \
     \
     extern "C" EXPORT BluePrint::NodeTypeInfo* create() { \
-        return new BluePrint::NodeTypeInfo\
+        auto info = new BluePrint::NodeTypeInfo\
         ( \
             BluePrint::fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -502,6 +695,8 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
         ); \
+        info->m_Caps = ::BluePrint::NodeCapsOf<BluePrint::type>(); \
+        return info; \
     } \
     \
     extern "C" EXPORT void destroy(BluePrint::NodeTypeInfo* pObj) { \
@@ -517,7 +712,7 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
     } \
     \
     extern "C" EXPORT BluePrint::NodeTypeInfo* create() { \
-        return new BluePrint::NodeTypeInfo\
+        auto info = new BluePrint::NodeTypeInfo\
         ( \
             BluePrint::fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -531,6 +726,8 @@ IMGUI_API ID_TYPE GetNodeTypeID(const std::string type, const std::string catalo
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
         ); \
+        info->m_Caps = ::BluePrint::NodeCapsOf<BluePrint::type>(); \
+        return info; \
     } \
     \
     extern "C" EXPORT void destroy(BluePrint::NodeTypeInfo* pObj) { \
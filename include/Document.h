@@ -14,11 +14,15 @@ namespace BluePrint
 {
 struct IMGUI_API Document
 {
+    // State parts are never changed in place, a copy of a state shares them with the original.
+    // Undo steps and background save snapshots cost a few reference counts, not a json copy.
+    using StateValue = shared_ptr<const imgui_json::value>;
+
     struct DocumentState
     {
-        imgui_json::value m_NodesState;
-        imgui_json::value m_SelectionState;
-        imgui_json::value m_BlueprintState;
+        StateValue m_NodesState;
+        StateValue m_SelectionState;
+        StateValue m_BlueprintState;
 
         imgui_json::value Serialize() const;
 
@@ -65,6 +69,8 @@ struct IMGUI_API Document
         shared_ptr<UndoTransaction> m_MasterTransaction;
     };
 
+    struct SaveWorker;
+
     [[nodiscard]]
     shared_ptr<UndoTransaction> BeginUndoTransaction(std::string name, std::string action = "");
     [[nodiscard]]
@@ -81,6 +87,10 @@ struct IMGUI_API Document
     int  Import(std::string path, ImVec2 pos);
     bool Save(std::string path) const;
     bool Save() const;
+    bool SaveAsync(std::string path = "");                  // Snapshot now, serialize and write the file on background thread
+    bool FlushSave() const;                                 // Wait for pending background saves, return result of last write
+    void SetAutoSave(bool enable, float interval = 60.f);   // Periodic background save to <path>.autosave while modified and changed
+    void UpdateAutoSave();                                  // Call once per frame
 
     bool Undo();
     bool Redo();
@@ -118,6 +128,12 @@ struct IMGUI_API Document
 
     BP                      m_Blueprint;
     void *                  m_UserData {nullptr};
+
+    shared_ptr<SaveWorker>  m_SaveWorker {nullptr};
+    bool                    m_AutoSave {false};
+    float                   m_AutoSaveInterval {60.f};
+    int64_t                 m_AutoSaveTime {0};
+    DocumentState           m_AutoSaveState;        // last state posted by autosave, an unchanged state is not written again
 };
 
 } // namespace BluePrint
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include <BluePrint.h>
+#include <unordered_map>
+
+namespace BluePrint
+{
+struct Node;
+struct Context;
+struct BP;
+
+// Pure data subgraphs of scalar nodes are lowered into register bytecode and evaluated by
+// ExprProgram::Run in one loop, instead of one EvaluatePin call and one PinValue per node.
+// Nodes take part by advertising NODE_CAPS_EXPR and implementing Node::CompileExpr, where they
+// emit opcodes through ExprCompiler. Plugin nodes can add their own opcodes with ExprCompiler::Call.
+
+# pragma region Expression
+enum class ExprType : uint8_t
+{
+    Bool = 0,
+    Int32,
+    Int64,
+    Float,
+    Double,
+    Count
+};
+
+IMGUI_API bool ExprTypeFromPinType(PinType pinType, ExprType& type);
+
+union ExprRegister
+{
+    bool    b;
+    int32_t i32;
+    int64_t i64;
+    float   f32;
+    double  f64;
+};
+
+enum class ExprOp : uint8_t
+{
+    Load = 0,       // dst = value of m_Inputs[a], fails the run if it does not hold the operand type
+    Move,           // dst = a
+    Add,            // dst = a + b, bool is OR
+    Sub,            // dst = a - b
+    Mul,            // dst = a * b, bool is AND
+    Div,            // dst = a / b, same divide guard as the arithmetic nodes
+    Compare,        // dst(Int32) = 1, 0 or -1
+    Jump,           // pc = a
+    JumpIfNot,      // if (!b) pc = a, b is a Bool register
+    Call,           // dst = m_Function(a, b, c), custom opcode
+    Count
+};
+
+// Custom opcode body, arguments that were not given alias the destination register
+using ExprFunction = void (*)(ExprRegister& dst, const ExprRegister& a, const ExprRegister& b, const ExprRegister& c);
+
+// Opcode and operand type packed together so the interpreter dispatches on a single switch
+constexpr uint16_t ExprCode(ExprOp op, ExprType type)
+{
+    return uint16_t(op) * uint16_t(ExprType::Count) + uint16_t(type);
+}
+
+struct ExprInstr
+{
+    uint16_t        m_Code  {0};
+    uint16_t        m_Dst   {0};
+    uint16_t        m_A     {0};
+    uint16_t        m_B     {0};
+    uint16_t        m_C     {0};
+    ExprFunction    m_Function {nullptr};
+};
+
+struct IMGUI_API ExprProgram
+{
+    // Evaluates the program, false when a loaded value has an unexpected type. Callers then
+    // fall back to EvaluatePin, which reports the same error the way the node always did.
+    bool Run(const Context& context, PinValue& value, bool threading = false) const;
+
+    std::vector<ExprInstr>      m_Code;
+    std::vector<const Pin*>     m_Inputs;       // pins read by Load, values outside the compiled region
+    uint16_t                    m_Registers {0};
+    uint16_t                    m_Result {0};
+    ExprType                    m_ResultType {ExprType::Int32};
+};
+
+// Builds an ExprProgram from a node output. Register results are int, -1 means the value
+// cannot be lowered, every method accepts -1 operands and passes the failure on.
+struct IMGUI_API ExprCompiler
+{
+    ExprCompiler(const BP* blueprint) : m_Blueprint(blueprint) {}
+
+    bool Compile(const Pin& output, ExprProgram& program);
+
+    int Input(const Pin& input, ExprType type);     // register holding the input, its provider is compiled in place when it can be
+    int Emit(ExprOp op, ExprType type, int a, int b = -1); // Move, Add, Sub, Mul, Div or Compare on operands of type
+    int Call(ExprFunction function, ExprType type, int a = -1, int b = -1, int c = -1);
+    int Select(int condition, const Pin& a, const Pin& b, ExprType type); // only the chosen input is evaluated
+
+    ExprType GetRegisterType(int reg) const { return m_Types[reg]; }
+
+private:
+    int Lower(const Pin& output);
+    int Output(const Pin& output, ExprType type);
+    int Load(const Pin& pin, ExprType type);
+    int Alloc(ExprType type);
+    int Push(ExprOp op, ExprType type, int dst, int a, int b = 0, int c = 0, ExprFunction function = nullptr);
+
+    const BP*                               m_Blueprint {nullptr};
+    ExprProgram*                            m_Program {nullptr};
+    std::vector<ExprType>                   m_Types;
+    std::unordered_map<const Pin*, int>     m_Memo;     // output pins already held in a register
+    std::vector<const Node*>                m_Lowering; // guards against cycles
+};
+# pragma endregion
+} // namespace BluePrint
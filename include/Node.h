@@ -7,6 +7,8 @@
 #include <imgui_curve.h>
 #include <inttypes.h>
 #include <DynObjectLoader.h>
+#include <unordered_map>
+#include <list>
 
 #if IMGUI_ICONS
 #define ICON_NODE               u8"\uf542"
@@ -70,6 +72,13 @@ struct BP;
 struct Node;
 struct Pin;
 struct Context;
+
+#define NODE_CAPS_NONE      (0)
+#define NODE_CAPS_PURE      (1<<1)  // data outputs depend only on data inputs, no flow and no state
+#define NODE_CAPS_CONST     (1<<2)  // data outputs only change when the node is edited
+#define NODE_CAPS_EXPR      (1<<3)  // node lowers data outputs into expression bytecode, see Node::CompileExpr
+#define NODE_CAPS_VOLATILE  (1<<4)  // outputs change without any input or setting change (time, counters, flow state)
+#define NODE_CAPS_TIME      (1<<5)  // outputs depend on time (BP::GetTimeStamp/GetDurtion or the clock) besides inputs and settings
 struct NodeTypeInfo
 {
     using Factory = Node*(*)(BP* blueprint);
@@ -99,6 +108,7 @@ struct NodeTypeInfo
     NodeStyle       m_Style;
     std::string     m_Catalog;
     Factory         m_Factory;
+    uint32_t        m_Caps {NODE_CAPS_NONE};
 
     std::string     m_Url;
 
@@ -127,6 +137,10 @@ struct IMGUI_API Node
 
     virtual void Update() {}  // Update Node
     virtual void PreLoad() {} // pre-load node resource
+    void EnsurePreLoad(); // run PreLoad once if it was deferred by lazy loading
+    void EnsureReset(Context& context); // run Reset once per run, the first time the node is executed or evaluated.
+                                        // Threaded runs (BP::Execute) reset all nodes up front on the caller's thread,
+                                        // so Reset runs on the thread that started the run, never on the worker.
 
     virtual void OnPause(Context& context) {}
     virtual void OnResume(Context& context) {}
@@ -166,6 +180,13 @@ struct IMGUI_API Node
         return pin.GetValue();
     }
 
+    // Emits the bytecode computing output and returns its register, or -1 to be evaluated through
+    // EvaluatePin. Only used when the type advertises NODE_CAPS_EXPR, see ExprCompiler.
+    virtual int CompileExpr(ExprCompiler& compiler, const Pin& output) const
+    {
+        return -1;
+    }
+
     virtual Pin* FindPin(std::string name)
     {
         auto inpins = GetInputPins();
@@ -221,6 +242,7 @@ struct IMGUI_API Node
     }
 
     virtual NodeTypeInfo    GetTypeInfo() const { return {}; }
+    uint32_t                GetCaps() const;    // GetTypeInfo().m_Caps, resolved once, runtime paths query it per step
 
     virtual NodeType        GetType() const;
     virtual VERSION_TYPE    GetVersion() const;
@@ -239,6 +261,7 @@ struct IMGUI_API Node
     virtual LinkQueryResult AcceptLink(const Pin& receiver, const Pin& provider); // Checks if node accept link between these two pins. There node can filter out unsupported link types.
     virtual void            WasLinked(const Pin& receiver, const Pin& provider); // Notifies node that link involving one of its pins has been made.
     virtual void            WasUnlinked(const Pin& receiver, const Pin& provider); // Notifies node that link involving one of its pins has been broken.
+    virtual bool            AcceptValueType(const Pin& receiver, PinType type) const; // Checks if receiver can take a value of this type at runtime, used by BP::InferTypes.
 
     virtual span<Pin*>      GetInputPins() { return {}; } // Returns list of input pins of the node
     virtual span<Pin*>      GetOutputPins() { return {}; } // Returns list of output pins of the node
@@ -250,7 +273,7 @@ struct IMGUI_API Node
     virtual void            OnNodeDelete(Node * node = nullptr) {};
 
     virtual int  Load(const imgui_json::value& value);
-    virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {});
+    virtual void Save(imgui_json::value& value, const IDMap& MapID = {});
 
     virtual bool DrawSettingLayout(ImGuiContext * ctx);
     virtual void DrawMenuLayout(ImGuiContext * ctx);
@@ -276,6 +299,10 @@ struct IMGUI_API Node
     float           m_Transparency      {0.0};
     ID_TYPE         m_GroupID           {0};
     std::mutex      m_mutex;
+    std::mutex      m_PreLoadMutex;
+    std::atomic<bool> m_PreLoaded       {true}; // false while PreLoad is deferred
+    mutable std::atomic<uint32_t> m_Caps {UINT32_MAX}; // cached by GetCaps, UINT32_MAX until resolved
+    std::atomic<uint32_t> m_ResetEpoch  {0};    // Context::m_ResetEpoch of the last Reset
 
     // for Node banchmark
     uint64_t        m_Tick {0};
@@ -319,26 +346,54 @@ struct ClipNode
 
 struct IMGUI_API NodeRegistry
 {
+    // opened but not yet registered plugin, OpenNodeModule touches no registry state
+    // so modules can be opened on worker threads and registered in a fixed order
+    struct NodeModule
+    {
+        std::string                 m_Path;
+        DLClass<NodeTypeInfo>*      m_Object {nullptr};
+        shared_ptr<NodeTypeInfo>    m_Info {nullptr};
+    };
+
     NodeRegistry();
     ~NodeRegistry();
     ID_TYPE RegisterNodeType(shared_ptr<NodeTypeInfo> info);
     ID_TYPE RegisterNodeType(std::string Path);
+    static NodeModule OpenNodeModule(std::string Path);
+    ID_TYPE RegisterNodeModule(NodeModule& module);
+    std::vector<ID_TYPE> RegisterNodeTypes(span<const std::string> paths); // batch register, types are rebuilt once
+    void BeginRegistration();   // defer type rebuild until matching EndRegistration, calls may nest. The old types stay visible meanwhile
+    void EndRegistration();
     void UnregisterNodeType(std::string name);
+    bool LoadManifest(std::string path);        // register types from plugin manifest, plugins are opened on first Create
+    bool SaveManifest(std::string path) const;  // write manifest of every registered plugin
+    bool HasPlugin(std::string path) const;     // plugin already registered, either loaded or from manifest
     Node* Create(ID_TYPE typeId, BP* blueprint);
     Node* Create(std::string typeName, BP* blueprint);
     span<const NodeTypeInfo* const> GetTypes() const;
     span<const std::string> GetCatalogs() const;
-    span<const Node * const> GetNodes() const;
+    span<const Node * const> GetNodes() const; // prototype nodes, created on first call after types change
     const NodeTypeInfo* GetTypeInfo(ID_TYPE typeId) const;
 
 private:
     void RebuildTypes();
+    void RequestRebuildTypes();
+    void ForgetType(const NodeTypeInfo* typeInfo);
+    NodeTypeInfo::Factory ResolveDeferredType(NodeTypeInfo& typeInfo);
     std::vector<NodeTypeInfo>   m_BuildInNodes;
-    std::vector<NodeTypeInfo>   m_CustomNodes;
+    std::list<NodeTypeInfo>     m_CustomNodes;  // list, so registering never moves entries the index points at
     std::vector<NodeTypeInfo*>  m_Types;
+    std::unordered_map<ID_TYPE, NodeTypeInfo*>      m_TypesByID;    // rebuilt with m_Types
+    std::unordered_map<std::string, NodeTypeInfo*>  m_TypesByName;  // first type in ID order wins on name clash
     std::vector<std::string>    m_Catalogs;
     std::vector<DLClass<NodeTypeInfo>*> m_ExternalObject;
-    std::vector<Node *>         m_Nodes;
+    mutable std::vector<Node *> m_Nodes;
+    mutable bool                m_NodesDirty {true};
+    mutable std::mutex          m_NodesMutex;
+    mutable std::mutex          m_DeferredMutex; // guards m_Factory of deferred types and m_ExternalObject
+    std::map<std::string, ID_TYPE> m_PluginPaths; // plugin file path -> type id
+    int                         m_RegistrationDepth {0};
+    bool                        m_TypesDirty {false};
 };
 
 } // namespace BluePrint
@@ -367,4 +422,42 @@ namespace BluePrint
     }
 }// namespace BluePrint
 
+namespace BluePrint
+{
+    // Node classes declare "static constexpr bool IsPure = true;" to get NODE_CAPS_PURE from BP_NODE* macros,
+    // "IsConstant" gives NODE_CAPS_CONST
+    template <typename T, typename = void>
+    struct NodeIsPure : std::false_type {};
+    template <typename T>
+    struct NodeIsPure<T, std::void_t<decltype(T::IsPure)>> : std::integral_constant<bool, T::IsPure> {};
+    template <typename T, typename = void>
+    struct NodeIsConstant : std::false_type {};
+    template <typename T>
+    struct NodeIsConstant<T, std::void_t<decltype(T::IsConstant)>> : std::integral_constant<bool, T::IsConstant> {};
+    // "static constexpr bool HasCompileExpr = true;" gives NODE_CAPS_EXPR
+    template <typename T, typename = void>
+    struct NodeHasCompileExpr : std::false_type {};
+    template <typename T>
+    struct NodeHasCompileExpr<T, std::void_t<decltype(T::HasCompileExpr)>> : std::integral_constant<bool, T::HasCompileExpr> {};
+    // "static constexpr bool IsVolatile = true;" gives NODE_CAPS_VOLATILE
+    template <typename T, typename = void>
+    struct NodeIsVolatile : std::false_type {};
+    template <typename T>
+    struct NodeIsVolatile<T, std::void_t<decltype(T::IsVolatile)>> : std::integral_constant<bool, T::IsVolatile> {};
+    // "static constexpr bool IsTimeDependent = true;" gives NODE_CAPS_TIME
+    template <typename T, typename = void>
+    struct NodeIsTimeDependent : std::false_type {};
+    template <typename T>
+    struct NodeIsTimeDependent<T, std::void_t<decltype(T::IsTimeDependent)>> : std::integral_constant<bool, T::IsTimeDependent> {};
+    template <typename T>
+    constexpr uint32_t NodeCapsOf()
+    {
+        return (NodeIsPure<T>::value ? NODE_CAPS_PURE : NODE_CAPS_NONE) |
+               (NodeIsConstant<T>::value ? NODE_CAPS_CONST : NODE_CAPS_NONE) |
+               (NodeHasCompileExpr<T>::value ? NODE_CAPS_EXPR : NODE_CAPS_NONE) |
+               (NodeIsVolatile<T>::value ? NODE_CAPS_VOLATILE : NODE_CAPS_NONE) |
+               (NodeIsTimeDependent<T>::value ? NODE_CAPS_TIME : NODE_CAPS_NONE);
+    }
+}// namespace BluePrint
+
 #define IS_ENTRY_EXIT_NODE(type) (type == BluePrint::NodeType::EntryPoint || type == BluePrint::NodeType::ExitPoint)
\ No newline at end of file
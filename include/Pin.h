@@ -2,6 +2,8 @@
 #include <iostream>
 #include <BluePrint.h>
 #include <immat.h>
+#include <unordered_map>
+#include <new>
 
 #define PIN_FLAG_NONE       (0)
 #define PIN_FLAG_IN         (1<<0)
@@ -33,9 +35,14 @@ enum class PinType: int32_t
     Vec4,
     Mat,
     Array,
-    Custom
+    Custom,
+    FloatArray,
+    Int32Array,
+    Vec4Array
 };
 
+inline bool IsTypedArrayPinType(PinType type) { return type == PinType::FloatArray || type == PinType::Int32Array || type == PinType::Vec4Array; }
+
 class IMGUI_API PinTypeEx
 {
 public:
@@ -65,11 +72,121 @@ struct PinValueEx
     virtual void* GetVoidPtr() const = 0;
 };
 
+// Custom values are immutable once published, so copies of a PinValue share
+// them, copying a custom PinValue is a reference count increment
+using PinValueExPtr = std::shared_ptr<PinValueEx>;
+
+// Refcounted immutable handle for the heavy PinValue alternatives (string,
+// mat, array), copies share the payload and AsMutable detaches on write
+template <typename T>
+struct PinValueShared
+{
+    PinValueShared() = default;
+    explicit PinValueShared(T&& value): m_Ptr(std::make_shared<T>(std::move(value))) {}
+    explicit PinValueShared(const T& value): m_Ptr(std::make_shared<T>(value)) {}
+
+    const T& Get() const
+    {
+        static const T s_Empty {};
+        return m_Ptr ? *m_Ptr : s_Empty;
+    }
+
+    const void* Identity() const { return m_Ptr.get(); } // payload identity, copies share it
+
+    T& Mutable()
+    {
+        if (!m_Ptr || m_Ptr.use_count() > 1)
+            m_Ptr = std::make_shared<T>(Get());
+        return *m_Ptr;
+    }
+
+private:
+    std::shared_ptr<T> m_Ptr;
+};
+
+// Maps a value type to the alternative it is stored as inside PinValue
+template <typename T> struct PinValueStorage { using Type = T; static constexpr bool IsShared = false; };
+template <> struct PinValueStorage<std::string> { using Type = PinValueShared<std::string>; static constexpr bool IsShared = true; };
+template <> struct PinValueStorage<ImGui::ImMat> { using Type = PinValueShared<ImGui::ImMat>; static constexpr bool IsShared = true; };
+template <> struct PinValueStorage<imgui_json::array> { using Type = PinValueShared<imgui_json::array>; static constexpr bool IsShared = true; };
+
+// Allocator for PinArray storage, keeps numeric buffers aligned for vector loads
+template <typename T, size_t Align = 16>
+struct PinArrayAllocator
+{
+    using value_type = T;
+    template <typename U> struct rebind { using other = PinArrayAllocator<U, Align>; };
+
+    PinArrayAllocator() = default;
+    template <typename U> PinArrayAllocator(const PinArrayAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align))); }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(Align)); }
+
+    template <typename U> bool operator==(const PinArrayAllocator<U, Align>&) const { return true; }
+    template <typename U> bool operator!=(const PinArrayAllocator<U, Align>&) const { return false; }
+};
+
+// Contiguous numeric array carried by the typed array pins (FloatArray, Int32Array, Vec4Array)
+template <typename T>
+struct PinArray
+{
+    using value_type = T;
+    using Storage = std::vector<T, PinArrayAllocator<T>>;
+
+    PinArray() = default;
+    explicit PinArray(size_t size, const T& value = T{}): m_Data(size, value) {}
+    PinArray(span<const T> data): m_Data(data.begin(), data.end()) {}
+    PinArray(std::initializer_list<T> data): m_Data(data) {}
+
+    size_t   size() const  { return m_Data.size(); }
+    bool     empty() const { return m_Data.empty(); }
+    T*       data()        { return m_Data.data(); }
+    const T* data() const  { return m_Data.data(); }
+    T&       operator[](size_t i)       { return m_Data[i]; }
+    const T& operator[](size_t i) const { return m_Data[i]; }
+    auto     begin()       { return m_Data.begin(); }
+    auto     begin() const { return m_Data.begin(); }
+    auto     end()         { return m_Data.end(); }
+    auto     end() const   { return m_Data.end(); }
+
+    void resize(size_t size, const T& value = T{}) { m_Data.resize(size, value); }
+    void reserve(size_t size) { m_Data.reserve(size); }
+    void clear() { m_Data.clear(); }
+    void push_back(const T& value) { m_Data.push_back(value); }
+
+    span<T>       Span()       { return span<T>(m_Data.data(), m_Data.size()); }
+    span<const T> Span() const { return span<const T>(m_Data.data(), m_Data.size()); }
+
+private:
+    Storage m_Data;
+};
+
+using FloatArray = PinArray<float>;
+using Int32Array = PinArray<int32_t>;
+using Vec4Array  = PinArray<ImVec4>;
+
+template <> struct PinValueStorage<FloatArray> { using Type = PinValueShared<FloatArray>; static constexpr bool IsShared = true; };
+template <> struct PinValueStorage<Int32Array> { using Type = PinValueShared<Int32Array>; static constexpr bool IsShared = true; };
+template <> struct PinValueStorage<Vec4Array> { using Type = PinValueShared<Vec4Array>; static constexpr bool IsShared = true; };
+
+// Conversion between typed arrays and the dynamically typed JSON array pin, returns false
+// when an element has no numeric representation of the target type
+IMGUI_API imgui_json::array PinArrayToJson(const FloatArray& array);
+IMGUI_API imgui_json::array PinArrayToJson(const Int32Array& array);
+IMGUI_API imgui_json::array PinArrayToJson(const Vec4Array& array);
+IMGUI_API bool PinArrayFromJson(const imgui_json::array& json, FloatArray& array);
+IMGUI_API bool PinArrayFromJson(const imgui_json::array& json, Int32Array& array);
+IMGUI_API bool PinArrayFromJson(const imgui_json::array& json, Vec4Array& array);
+
 struct LinkQueryResult;
 struct FlowPin;
 struct PinValue
 {
-    using ValueType = variant<monostate, FlowPin*, bool, int32_t, int64_t, float, double, std::string, uintptr_t, ImVec2, ImVec4, ImGui::ImMat, imgui_json::array, PinValueEx*>;
+    // Alternative order must follow PinType, GetType() is the variant index.
+    // Scalars and vectors are stored inline, heavy payloads are shared handles
+    using ValueType = variant<monostate, FlowPin*, bool, int32_t, int64_t, float, double, PinValueShared<std::string>, uintptr_t, ImVec2, ImVec4, PinValueShared<ImGui::ImMat>, PinValueShared<imgui_json::array>, PinValueExPtr,
+                              PinValueShared<FloatArray>, PinValueShared<Int32Array>, PinValueShared<Vec4Array>>;
 
     PinValue() = default;
     PinValue(const PinValue&) = default;
@@ -84,43 +201,72 @@ struct PinValue
     PinValue(float value): m_Value(value) {}
     PinValue(double value): m_Value(value) {}
     PinValue(uintptr_t value): m_Value(value) {}
-    PinValue(std::string&& value): m_Value(std::move(value)) {}
-    PinValue(const std::string& value): m_Value(value) {}
-    PinValue(const char* value): m_Value(std::string(value)) {}
+    PinValue(std::string&& value): m_Value(PinValueShared<std::string>(std::move(value))) {}
+    PinValue(const std::string& value): m_Value(PinValueShared<std::string>(value)) {}
+    PinValue(const char* value): m_Value(PinValueShared<std::string>(std::string(value))) {}
     PinValue(const ImVec2 value): m_Value(value) {}
     PinValue(const ImVec4 value): m_Value(value) {}
-    PinValue(ImGui::ImMat value): m_Value(value) {}
-    PinValue(imgui_json::array value): m_Value(value) {}
-    PinValue(PinValueEx* valex)
+    PinValue(ImGui::ImMat value): m_Value(PinValueShared<ImGui::ImMat>(std::move(value))) {}
+    PinValue(imgui_json::array value): m_Value(PinValueShared<imgui_json::array>(std::move(value))) {}
+    PinValue(FloatArray value): m_Value(PinValueShared<FloatArray>(std::move(value))) {}
+    PinValue(Int32Array value): m_Value(PinValueShared<Int32Array>(std::move(value))) {}
+    PinValue(Vec4Array value): m_Value(PinValueShared<Vec4Array>(std::move(value))) {}
+    PinValue(const PinValueEx* valex): m_Value(PinValueExPtr(valex ? valex->CreateCopy() : nullptr)) {} // caller keeps ownership, value is copied
+    PinValue(PinValueEx*&& valex): m_Value(PinValueExPtr(valex)) {} // takes ownership
+    PinValue(PinValueExPtr valex): m_Value(std::move(valex)) {}   // shared, no copy
+
+    PinType GetType() const { return static_cast<PinType>(m_Value.index()); }
+
+    // fnv1a over the value continuing from seed, strings and typed arrays hash by content, mats by buffer
+    // and shape, other shared payloads by identity
+    uint64_t Hash(uint64_t seed) const;
+    // Same value as other without trusting a hash: inline values, strings and typed arrays compare by content,
+    // mats by buffer and shape, other shared payloads by identity. Callers keep other alive so no address is
+    // recycled.
+    bool SameAs(const PinValue& other) const;
+    // Approximate memory the value keeps alive, including the whole shared payload
+    size_t ByteSize() const;
+
+    // Shared payloads are immutable, As<T>() on them always returns a const
+    // reference, use AsMutable<T>() to detach a private copy before writing
+    template <typename T>
+    decltype(auto) As()
     {
-        if (valex)
-            m_Value = valex->CreateCopy();
+        if constexpr (PinValueStorage<T>::IsShared)
+            return get<typename PinValueStorage<T>::Type>(m_Value).Get();
         else
-            m_Value = valex;
+            return get<T>(m_Value);
     }
-    PinValue(PinValueEx*&& valex): m_Value(std::move(valex)) {}
 
-    ~PinValue()
+    template <typename T>
+    const T& As() const
     {
-        if (GetType() == PinType::Custom)
-        {
-            PinValueEx* pPinValEx = As<PinValueEx*>();
-            delete pPinValEx;
-        }
+        if constexpr (PinValueStorage<T>::IsShared)
+            return get<typename PinValueStorage<T>::Type>(m_Value).Get();
+        else
+            return get<T>(m_Value);
     }
 
-    PinType GetType() const { return static_cast<PinType>(m_Value.index()); }
-
+    // Pointer to the held T, or nullptr when the value holds another type
     template <typename T>
-    T& As()
+    const T* TryAs() const
     {
-        return get<T>(m_Value);
+        if constexpr (PinValueStorage<T>::IsShared)
+        {
+            auto handle = get_if<typename PinValueStorage<T>::Type>(&m_Value);
+            return handle ? &handle->Get() : nullptr;
+        }
+        else
+            return get_if<T>(&m_Value);
     }
 
     template <typename T>
-    const T& As() const
+    T& AsMutable()
     {
-        return get<T>(m_Value);
+        if constexpr (PinValueStorage<T>::IsShared)
+            return get<typename PinValueStorage<T>::Type>(m_Value).Mutable();
+        else
+            return get<T>(m_Value);
     }
 
 private:
@@ -157,7 +303,7 @@ struct IMGUI_API Pin
     bool IsLinkedExportedPin() const;                   // Pin is linked with group export pin
 
     virtual bool Load(const imgui_json::value& value);
-    virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const;
+    virtual void Save(imgui_json::value& value, const IDMap& MapID = {}) const;
 
     ID_TYPE         m_ID        {static_cast<ID_TYPE>(-1)};
     Node*           m_Node      {nullptr};
@@ -204,6 +350,9 @@ public:
     T* GetValuePtr() const
     { return m_Shptr.get(); }
 
+    const std::shared_ptr<T>& GetValueShared() const
+    { return m_Shptr; }
+
     const std::type_info& GetTypeInfo() const override
     { return typeid(T); }
 
@@ -233,68 +382,84 @@ private:
     std::shared_ptr<T>  m_Shptr;
 };
 
+// The payload is published as an immutable snapshot through an atomic shared_ptr.
+// Readers take a snapshot without locking or allocating, writers swap in a new one.
 class IMGUI_API PinEx
 {
 public:
     PinEx() {}
-    virtual ~PinEx()
+    virtual ~PinEx() {}
+
+    virtual const PinTypeEx& GetTypeEx() const = 0;
+
+    std::shared_ptr<PinValueEx> LoadPinValueEx() const
     {
-        if (m_pPinValueEx)
-        {
-            delete m_pPinValueEx;
-            m_pPinValueEx = nullptr;
-        }
+        return std::atomic_load(&m_pPinValueEx);
     }
 
-    virtual const PinTypeEx& GetTypeEx() const = 0;
+    void PublishPinValueEx(std::shared_ptr<PinValueEx> pPinValueEx)
+    {
+        std::atomic_store(&m_pPinValueEx, std::move(pPinValueEx));
+    }
+
+    void PublishPinValueEx(PinValueEx* pPinValueEx) // takes ownership
+    {
+        PublishPinValueEx(std::shared_ptr<PinValueEx>(pPinValueEx));
+    }
 
     PinValue GetPointPinValue() const
     {
-        return PinValue(reinterpret_cast<uintptr_t>(m_pPinValueEx));
+        return PinValue(reinterpret_cast<uintptr_t>(LoadPinValueEx().get()));
     }
 
     PinValue GetCustomPinValue() const
     {
-        return PinValue(m_pPinValueEx);
+        return PinValue(LoadPinValueEx());
     }
 
     void SetPinValueEx(const PinValueEx* pPinValueEx)
     {
-        if (m_pPinValueEx && pPinValueEx && m_pPinValueEx->CheckIdentical(*pPinValueEx)) 
+        auto current = LoadPinValueEx();
+        if (current && pPinValueEx && current->CheckIdentical(*pPinValueEx)) 
         {
             return;
         }
-        if (m_pPinValueEx) 
-        {
-            delete m_pPinValueEx;
-            m_pPinValueEx = nullptr;
-        }
-        if (pPinValueEx)
+        PublishPinValueEx(pPinValueEx ? pPinValueEx->CreateCopy() : nullptr);
+    }
+
+    void SetPinValueEx(const PinValueExPtr& pPinValueEx) // share the published value, no copy
+    {
+        auto current = LoadPinValueEx();
+        if (current == pPinValueEx || (current && pPinValueEx && current->CheckIdentical(*pPinValueEx)))
         {
-            m_pPinValueEx = pPinValueEx->CreateCopy();
+            return;
         }
+        PublishPinValueEx(pPinValueEx);
     }
 
     virtual void SetValuePtr(void* valuePtr, const std::type_info& typeInfo) = 0;
 
+    // No raw pointer accessor, the provider may publish a new value and release the old one
+    // while the reader still uses it. The returned snapshot keeps the value alive.
     template<class T>
-    T* GetValuePtr() const
+    std::shared_ptr<T> GetValueShared() const
     {
-        if (!m_pPinValueEx)
+        auto snapshot = LoadPinValueEx();
+        if (!snapshot)
             return nullptr;
         const std::type_info& typeinfo1 = typeid(T);
-        const std::type_info& typeinfo2 = m_pPinValueEx->GetTypeInfo();
+        const std::type_info& typeinfo2 = snapshot->GetTypeInfo();
         if (typeinfo1 != typeinfo2)
         {
             std::stringstream ss;
             ss << "PinValueExImpl value type MISMATCH! '" << typeinfo1.name() << "' != '" << typeinfo2.name() << "'.";
             throw std::runtime_error(ss.str());
         }
-        return (static_cast<PinValueExImpl<T>*>(m_pPinValueEx))->GetValuePtr();
+        return (static_cast<PinValueExImpl<T>*>(snapshot.get()))->GetValueShared();
     }
 
 protected:
-    PinValueEx*     m_pPinValueEx   {nullptr};
+    std::shared_ptr<PinValueEx> m_pPinValueEx   {nullptr}; // access through LoadPinValueEx/PublishPinValueEx only
 };
 
 // ----------------------------
@@ -325,7 +490,7 @@ struct IMGUI_API AnyPin final : Pin
     PinValue GetValue() const override { return m_InnerPin ? m_InnerPin->GetValue() : PinValue{}; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     std::unique_ptr<Pin> m_InnerPin;
 };
@@ -364,7 +529,7 @@ struct IMGUI_API BoolPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     bool m_Value = false;
 };
@@ -388,7 +553,7 @@ struct IMGUI_API Int32Pin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     int32_t m_Value = 0;
 };
@@ -412,7 +577,7 @@ struct IMGUI_API Int64Pin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     int64_t m_Value = 0;
 };
@@ -435,7 +600,7 @@ struct IMGUI_API FloatPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     float m_Value = 0.0f;
 };
@@ -458,7 +623,7 @@ struct IMGUI_API DoublePin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     double m_Value = 0.0f;
 };
@@ -482,7 +647,7 @@ struct IMGUI_API StringPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     std::string m_Value;
 };
@@ -506,7 +671,7 @@ struct IMGUI_API PointPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     uintptr_t m_Value;
 };
@@ -529,7 +694,7 @@ struct IMGUI_API Vec2Pin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     ImVec2 m_Value {0.f, 0.f};
 };
@@ -552,7 +717,7 @@ struct IMGUI_API Vec4Pin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     ImVec4 m_Value {0.f, 0.f, 0.f, 0.f};
 };
@@ -566,6 +731,13 @@ struct IMGUI_API ArrayPin final : Pin
 
     bool SetValue(const PinValue& value) override
     {
+        switch (value.GetType())
+        {
+            case PinType::FloatArray: m_Value = PinArrayToJson(value.As<FloatArray>()); return true;
+            case PinType::Int32Array: m_Value = PinArrayToJson(value.As<Int32Array>()); return true;
+            case PinType::Vec4Array:  m_Value = PinArrayToJson(value.As<Vec4Array>()); return true;
+            default: break;
+        }
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<imgui_json::array>();
@@ -575,7 +747,7 @@ struct IMGUI_API ArrayPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     imgui_json::array m_Value;
 };
@@ -598,10 +770,84 @@ struct IMGUI_API MatPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     ImGui::ImMat m_Value = {};
 };
+
+// Typed numeric array pins, values are contiguous and accept a JSON Array value by conversion
+struct IMGUI_API FloatArrayPin final : Pin
+{
+    static constexpr auto TypeId = PinType::FloatArray;
+    FloatArrayPin(Node* node, FloatArray value = {}): Pin(node, PinType::FloatArray), m_Value(std::move(value)) {}
+    FloatArrayPin(Node* node, std::string name, FloatArray value = {}): Pin(node, PinType::FloatArray, name), m_Value(std::move(value)) {}
+
+    bool SetValue(const PinValue& value) override
+    {
+        if (value.GetType() == PinType::Array)
+            return PinArrayFromJson(value.As<imgui_json::array>(), m_Value);
+        if (value.GetType() != TypeId)
+            return false;
+        m_Value = value.As<FloatArray>();
+        return true;
+    }
+
+    PinValue GetValue() const override { return m_Value; }
+
+    bool Load(const imgui_json::value& value) override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
+
+    FloatArray m_Value;
+};
+
+struct IMGUI_API Int32ArrayPin final : Pin
+{
+    static constexpr auto TypeId = PinType::Int32Array;
+    Int32ArrayPin(Node* node, Int32Array value = {}): Pin(node, PinType::Int32Array), m_Value(std::move(value)) {}
+    Int32ArrayPin(Node* node, std::string name, Int32Array value = {}): Pin(node, PinType::Int32Array, name), m_Value(std::move(value)) {}
+
+    bool SetValue(const PinValue& value) override
+    {
+        if (value.GetType() == PinType::Array)
+            return PinArrayFromJson(value.As<imgui_json::array>(), m_Value);
+        if (value.GetType() != TypeId)
+            return false;
+        m_Value = value.As<Int32Array>();
+        return true;
+    }
+
+    PinValue GetValue() const override { return m_Value; }
+
+    bool Load(const imgui_json::value& value) override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
+
+    Int32Array m_Value;
+};
+
+struct IMGUI_API Vec4ArrayPin final : Pin
+{
+    static constexpr auto TypeId = PinType::Vec4Array;
+    Vec4ArrayPin(Node* node, Vec4Array value = {}): Pin(node, PinType::Vec4Array), m_Value(std::move(value)) {}
+    Vec4ArrayPin(Node* node, std::string name, Vec4Array value = {}): Pin(node, PinType::Vec4Array, name), m_Value(std::move(value)) {}
+
+    bool SetValue(const PinValue& value) override
+    {
+        if (value.GetType() == PinType::Array)
+            return PinArrayFromJson(value.As<imgui_json::array>(), m_Value);
+        if (value.GetType() != TypeId)
+            return false;
+        m_Value = value.As<Vec4Array>();
+        return true;
+    }
+
+    PinValue GetValue() const override { return m_Value; }
+
+    bool Load(const imgui_json::value& value) override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
+
+    Vec4Array m_Value;
+};
+
 struct IMGUI_API CustomPin final : Pin
 {
     static constexpr auto TypeId = PinType::Custom;
@@ -621,9 +867,7 @@ struct IMGUI_API CustomPin final : Pin
     {
         if (value.GetType() != TypeId)
             return false;
-        m_DataAccessLock.lock();
-        m_pPinEx->SetPinValueEx(value.As<PinValueEx*>());
-        m_DataAccessLock.unlock();
+        m_pPinEx->SetPinValueEx(value.As<PinValueExPtr>());
         return true;
     }
 
@@ -641,14 +885,14 @@ struct IMGUI_API CustomPin final : Pin
     }
 
     template<class T>
-    T* GetValuePtr()
+    std::shared_ptr<T> GetValueShared() // snapshot stays valid even if provider publishes a new value
     {
         SyncValue();
-        return m_pPinEx->GetValuePtr<T>();
+        return m_pPinEx->GetValueShared<T>();
     }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) const override;
 
     LinkQueryResult CanLinkTo(const Pin& pin) const override;
     PinEx& GetPinEx() const { return *m_pPinEx; }
@@ -656,7 +900,6 @@ struct IMGUI_API CustomPin final : Pin
 private:
     std::string     m_ExTypeName        {""};
     PinEx*          m_pPinEx            {nullptr};
-    std::mutex      m_DataAccessLock;
 };
 
 class PinExRegistry
@@ -665,12 +908,24 @@ public:
     PinExRegistry() {}
     ~PinExRegistry();
 
+    // opened but not yet registered module, OpenPinExModule touches no registry state
+    struct PinExModule
+    {
+        std::string             m_Path;
+        void*                   m_Handle {nullptr};
+        const PinExModuleInfo*  m_Info {nullptr};
+    };
+
     const PinTypeEx* RegisterPinEx(std::string module_path);
-    PinEx* Create(std::string typeName);
+    static PinExModule OpenPinExModule(std::string module_path);
+    const PinTypeEx* RegisterPinExModule(PinExModule& module);
+    PinEx* Create(const std::string& typeName);
 
 private:
     std::vector<const PinExModuleInfo*>  m_TypeInfos;
-    void* m_dll_handle {nullptr};
+    std::unordered_map<std::string, const PinExModuleInfo*> m_TypeIndex;
+    std::vector<void*>  m_ModuleHandles; // every loaded module, closed on destruction
+    std::mutex          m_Mutex;
 };
 } // namespace BluePrint
 
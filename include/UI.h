@@ -226,7 +226,7 @@ typedef struct BluePrintCallbackFunctions
 
 struct IMGUI_API BluePrintUI
 {
-    static void LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count);
+    static void LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count, std::string manifest_path = "");
     static int CheckPlugins(const std::vector<std::string>& pluginPaths);
     BluePrintUI();
     void Initialize(const char * bp_file = nullptr);
@@ -332,6 +332,7 @@ public:
     Node* FindExitPointNode();
 
     bool Blueprint_SetFilter(const std::string name, const PinValue& value);
+    bool Blueprint_MarkNodeDirty(ID_TYPE id);   // host changed settings or pin values of node outside the editor
     bool Blueprint_RunFilter(ImGui::ImMat& input, ImGui::ImMat& output, int64_t current, int64_t duration, bool bypass_bg_node = false);
     bool Blueprint_SetTransition(const std::string name, const PinValue& value);
     bool Blueprint_RunTransition(ImGui::ImMat& input_first, ImGui::ImMat& input_second, ImGui::ImMat& output, int64_t current, int64_t duration, bool bypass_bg_node = false);
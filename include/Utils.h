@@ -32,7 +32,7 @@ const vector<Node*> GetGroupedNodes(Node& node); // Returns grouped nodes as a v
 const vector<Pin*> GetSelectedLinks(BP* blueprint); // Returns selected links as a vector.
 const char * StepResultToString(StepResult stepResult);
 std::string IDToHexString(const ID_TYPE i);
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID);
+ID_TYPE GetIDFromMap(ID_TYPE ID, const IDMap& MapID);
 // Uses ImDrawListSplitter to draw background under pin value
 struct PinValueBackgroundRenderer
 {
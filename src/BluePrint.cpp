@@ -3,6 +3,11 @@
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
 #include <imgui_node_editor.h>
+#include <fstream>
+#include <sstream>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ed = ax::NodeEditor;
 
@@ -29,6 +34,13 @@ ID_TYPE IDGenerator::GenerateID()
     return m_State ++;//= ImGui::get_current_time_long(); // TODO::Dicky add better Unique ID generator
 }
 
+ID_TYPE IDGenerator::GenerateIDRange(ID_TYPE count)
+{
+    auto first = m_State;
+    m_State += count;
+    return first;
+}
+
 void IDGenerator::SetState(ID_TYPE state)
 {
     m_State = state;
@@ -39,6 +51,69 @@ ID_TYPE IDGenerator::State() const
     return m_State;
 }
 
+// -----------------------------
+// ---------[ IDMap ]-----------
+// -----------------------------
+void IDMap::Reserve(size_t size)
+{
+    m_Entries.reserve(size);
+}
+
+void IDMap::Set(ID_TYPE from, ID_TYPE to)
+{
+    if (!m_Entries.empty() && m_Entries.back().first >= from)
+        m_Sorted = false;
+    m_Entries.emplace_back(from, to);
+}
+
+void IDMap::Build()
+{
+    if (m_Sorted)
+        return;
+    // stable sort keep insert order of duplicated ID, so we can keep the last one
+    std::stable_sort(m_Entries.begin(), m_Entries.end(), [](const std::pair<ID_TYPE, ID_TYPE>& lhs, const std::pair<ID_TYPE, ID_TYPE>& rhs)
+    {
+        return lhs.first < rhs.first;
+    });
+    auto out = m_Entries.begin();
+    for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+        auto next = it + 1;
+        if (next != m_Entries.end() && next->first == it->first)
+            continue;
+        *out++ = *it;
+    }
+    m_Entries.erase(out, m_Entries.end());
+    m_Sorted = true;
+}
+
+void IDMap::Clear()
+{
+    m_Entries.clear();
+    m_Sorted = true;
+}
+
+ID_TYPE IDMap::Get(ID_TYPE from) const
+{
+    IM_ASSERT(m_Sorted);
+    auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), from, [](const std::pair<ID_TYPE, ID_TYPE>& entry, ID_TYPE id)
+    {
+        return entry.first < id;
+    });
+    if (it == m_Entries.end() || it->first != from)
+        return 0;
+    return it->second;
+}
+
+bool IDMap::Contains(ID_TYPE from) const
+{
+    IM_ASSERT(m_Sorted);
+    return std::binary_search(m_Entries.begin(), m_Entries.end(), std::make_pair(from, ID_TYPE(0)), [](const std::pair<ID_TYPE, ID_TYPE>& lhs, const std::pair<ID_TYPE, ID_TYPE>& rhs)
+    {
+        return lhs.first < rhs.first;
+    });
+}
+
 // ---------------------------
 // ----------[ BP ]-----------
 // ---------------------------
@@ -55,13 +130,10 @@ BP::BP(const BP& other)
 }
 
 BP::BP(BP&& other)
-    : m_Generator(std::move(other.m_Generator))
-    , m_Nodes(std::move(other.m_Nodes))
-    , m_Pins(std::move(other.m_Pins))
-    , m_Context(std::move(other.m_Context))
+    : BP()
 {
-    for (auto& node : m_Nodes)
-        node->m_Blueprint = this;
+    // move assignment stops the prefetch of other before any of its members move
+    *this = std::move(other);
 }
 
 BP::~BP()
@@ -90,10 +162,25 @@ BP& BP::operator=(BP&& other)
     if (this == &other)
         return *this;
 
+    StopPrefetch();
+    other.StopPrefetch();
     m_Generator     = std::move(other.m_Generator);
     m_Nodes         = std::move(other.m_Nodes);
     m_Pins          = std::move(other.m_Pins);
     m_Context       = std::move(other.m_Context);
+    m_TypeVerified  = other.m_TypeVerified;
+    m_TypeMismatches = std::move(other.m_TypeMismatches);
+    {
+        std::lock_guard<std::mutex> lock(m_FoldMutex);
+        m_Folds.clear();
+        m_FoldsDirty = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        m_Programs.clear();
+    }
+    DropNodeResults();
+    ClearOutputCache();
 
     for (auto& node : m_Nodes)
         node->m_Blueprint = this;
@@ -106,6 +193,7 @@ Node* BP::CreateNode(ID_TYPE nodeTypeId)
     if (!s_NodeRegistry)
         return nullptr;
 
+    StopPrefetch();
     auto node = s_NodeRegistry->Create(nodeTypeId, this);
     if (!node)
         return nullptr;
@@ -120,6 +208,7 @@ Node* BP::CreateNode(std::string nodeTypeName)
     if (!s_NodeRegistry)
         return nullptr;
 
+    StopPrefetch();
     auto node = s_NodeRegistry->Create(nodeTypeName, this);
     if (!node)
         return nullptr;
@@ -135,6 +224,7 @@ void BP::DeleteNode(Node* node)
     if (nodeIt == m_Nodes.end())
         return;
 
+    StopPrefetch();
     if (node->m_GroupID)
     {
         auto id = node->m_GroupID;
@@ -175,12 +265,14 @@ Node* BP::CloneNode(Node* node)
 
 void BP::InsertNode(Node* node)
 {
+    StopPrefetch();
     if (node)
         m_Nodes.emplace_back(node);
 }
 
 void BP::SwapNode(ID_TYPE src, ID_TYPE dst)
 {
+    StopPrefetch();
     auto iter_src = std::find_if(m_Nodes.begin(), m_Nodes.end(), [src](Node* node) {
         return node->m_ID == src;
     });
@@ -197,6 +289,18 @@ void BP::SwapNode(ID_TYPE src, ID_TYPE dst)
 
 void BP::ForgetPin(Pin* pin)
 {
+    StopPrefetch();
+    ClearOutputCache();
+    {
+        std::lock_guard<std::mutex> lock(m_FoldMutex);
+        m_FoldsDirty = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        m_Programs.clear();
+    }
+    DropNodeResults();
+
     auto pinIt = std::find(m_Pins.begin(), m_Pins.end(), pin);
     if (pinIt == m_Pins.end())
         return;
@@ -206,6 +310,7 @@ void BP::ForgetPin(Pin* pin)
 
 void BP::Clear()
 {
+    StopPrefetch();
     m_Context.Stop();
     m_IsOpen = false;
     for (auto node : m_Nodes)
@@ -224,6 +329,17 @@ void BP::Clear()
     m_Pins.resize(0);
     m_Generator = IDGenerator();
     m_Context = Context();
+    m_TypeVerified = false;
+    m_TypeMismatches.clear();
+    ClearOutputCache();
+    {
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        m_Programs.clear();
+    }
+    DropNodeResults();
+    std::lock_guard<std::mutex> lock(m_FoldMutex);
+    m_Folds.clear();
+    m_FoldsDirty = true;
 }
 
 span<Node*> BP::GetNodes()
@@ -381,8 +497,18 @@ StepResult BP::Execute(Node& entryPointNode, bool bypass_bg_node)
     if (nodeIt == m_Nodes.end())
         return StepResult::Error;
 
+    if (!m_Context.m_Executing && m_Incremental)
+        UpdateEntryFingerprint(entryPointNode);
     if (!m_Context.m_Executing)
+    {
         ResetState();
+#if !defined(__EMSCRIPTEN__)
+        // the run continues on a worker thread, reset every node here on the caller's thread so
+        // Reset overrides never run on the worker or race a node evaluated from another thread
+        for (auto node : m_Nodes)
+            node->EnsureReset(m_Context);
+#endif
+    }
     auto entry_pin = entryPointNode.GetOutputFlowPin();
     if (!entry_pin)
         return StepResult::Error;
@@ -399,6 +525,8 @@ StepResult BP::Run(Node& entryPointNode, bool bypass_bg_node)
     if (nodeIt == m_Nodes.end())
         return StepResult::Error;
 
+    if (!m_Context.m_Executing && m_Incremental)
+        UpdateEntryFingerprint(entryPointNode);
     if (!m_Context.m_Executing)
         ResetState();
 
@@ -523,6 +651,11 @@ Node * BP::CreateDummyNode(const imgui_json::value& value, BP* blueprint)
 }
 
 int BP::Load(const imgui_json::value& value)
+{
+    return Load(value, false);
+}
+
+int BP::Load(const imgui_json::value& value, bool typesResolved)
 {
     if (!value.is_object())
         return BP_ERR_NODE_LOAD;
@@ -533,13 +666,18 @@ int BP::Load(const imgui_json::value& value)
     if (!imgui_json::GetPtrTo(value, "nodes", nodeArray)) // required
         return BP_ERR_NODE_LOAD;
 
+    // AnyPin skips relinking while loading, InferTypes resolves all types once the nodes are in
+    m_Loading = true;
     //IDGenerator generator;
     for (auto& nodeValue : *nodeArray)
     {
         int ret = 0;
         ID_TYPE typeId;
         if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId)) // required
+        {
+            m_Loading = false;
             return BP_ERR_NODE_LOAD;
+        }
 
         auto node = s_NodeRegistry->Create(typeId, this);
         if (!node)
@@ -555,9 +693,17 @@ int BP::Load(const imgui_json::value& value)
             node->Load(nodeValue);
         }
 
-        node->PreLoad();
+        if (m_LazyPreLoad)
+            node->m_PreLoaded = false;
+        else
+            node->PreLoad();
         m_Nodes.emplace_back(node);
     }
+    m_Loading = false;
+    if (typesResolved)
+        m_TypeVerified = true;  // value was saved right after a successful InferTypes, Any pins carry their types
+    else
+        InferTypes();
 
     const imgui_json::object* stateObject = nullptr;
     if (!imgui_json::GetPtrTo(value, "state", stateObject)) // required
@@ -585,12 +731,14 @@ int BP::Import(const imgui_json::value& value, ImVec2 pos)
     if (!imgui_json::GetTo<imgui_json::number>(groupValue, "type_id", typeId)) // required
         return BP_ERR_GROUP_LOAD;
 
+    StopPrefetch();
     GroupNode *group_node = (GroupNode *)s_NodeRegistry->Create(typeId, this);
     if (!group_node)
         return BP_ERR_GROUP_LOAD;
 
     group_node->LoadGroup(value, pos);
     m_Nodes.emplace_back(group_node);
+    InferTypes();
 
     return BP_ERR_NONE;
 }
@@ -599,29 +747,236 @@ void BP::Save(imgui_json::value& value) const
 {
     auto& nodesValue = value["nodes"]; // required
     nodesValue = imgui_json::array();
+    nodesValue.get<imgui_json::array>().reserve(m_Nodes.size());
     for (auto& node : m_Nodes)
     {
         imgui_json::value nodeValue;
+        auto typeInfo = node->GetTypeInfo();
 
-        nodeValue["type_id"] = imgui_json::number(node->GetTypeInfo().m_ID); // required
-        nodeValue["type_name"] = node->GetTypeInfo().m_Name; // optional, to make data readable for humans
+        nodeValue["type_id"] = imgui_json::number(typeInfo.m_ID); // required
+        nodeValue["type_name"] = typeInfo.m_Name; // optional, to make data readable for humans
 
         node->Save(nodeValue);
 
-        nodesValue.push_back(nodeValue);
+        nodesValue.push_back(std::move(nodeValue));
     }
 
     auto& stateValue = value["state"]; // required
     stateValue["generator_state"] = imgui_json::number(m_Generator.State()); // required
 }
 
+// Load cache, the graph as saved right after Load and InferTypes passed, keyed by ContentHash of
+// the document it was loaded from. A hit loads that state without parsing the file or inferring
+// types again. Files map their raw bytes to the content key, so the key itself is found without
+// parsing. ContentHash covers the node type versions, a file hit checks them again because the
+// key was not recomputed, so upgrading a plugin drops the entry.
+struct LoadCacheTypeVersion
+{
+    ID_TYPE         m_ID {0};
+    VERSION_TYPE    m_Version {0};
+    VERSION_TYPE    m_SDK_Version {0};
+};
+
+struct LoadCacheEntry
+{
+    shared_ptr<const imgui_json::value>    m_Value;    // BP::Save of the loaded, type resolved graph
+    std::vector<LoadCacheTypeVersion>       m_Types;
+    std::vector<uint64_t>                   m_Files;    // raw file keys pointing at this entry
+};
+
+struct LoadCache
+{
+    using LRU = std::list<uint64_t>;
+    bool            m_Enabled {false};
+    size_t          m_Capacity {256};
+    LRU             m_Order; // most recently used first
+    std::unordered_map<uint64_t, std::pair<LoadCacheEntry, LRU::iterator>> m_Entries;
+    std::unordered_map<uint64_t, uint64_t> m_Files; // file content bytes -> ContentHash
+    std::mutex      m_Mutex;
+};
+
+static LoadCache s_LoadCache;
+
+static void CollectTypeVersions(const imgui_json::value& value, std::vector<LoadCacheTypeVersion>& types)
+{
+    const imgui_json::array* nodeArray = nullptr;
+    if (!imgui_json::GetPtrTo(value, "nodes", nodeArray))
+        return;
+    auto registry = BP::GetNodeRegistry();
+    for (auto& nodeValue : *nodeArray)
+    {
+        ID_TYPE typeId = 0;
+        if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId))
+            continue;
+        if (std::find_if(types.begin(), types.end(), [typeId](const LoadCacheTypeVersion& t) { return t.m_ID == typeId; }) != types.end())
+            continue;
+        LoadCacheTypeVersion type;
+        type.m_ID = typeId;
+        if (auto typeInfo = registry->GetTypeInfo(typeId))
+        {
+            type.m_Version = typeInfo->m_Version;
+            type.m_SDK_Version = typeInfo->m_SDK_Version;
+        }
+        types.push_back(type);
+    }
+}
+
+static bool TypeVersionsValid(const std::vector<LoadCacheTypeVersion>& types)
+{
+    auto registry = BP::GetNodeRegistry();
+    for (auto& type : types)
+    {
+        auto typeInfo = registry->GetTypeInfo(type.m_ID);
+        VERSION_TYPE version = typeInfo ? typeInfo->m_Version : 0;
+        VERSION_TYPE sdk_version = typeInfo ? typeInfo->m_SDK_Version : 0;
+        if (version != type.m_Version || sdk_version != type.m_SDK_Version)
+            return false;
+    }
+    return true;
+}
+
+// caller holds s_LoadCache.m_Mutex
+static void LoadCacheErase(std::unordered_map<uint64_t, std::pair<LoadCacheEntry, LoadCache::LRU::iterator>>::iterator it)
+{
+    for (auto file : it->second.first.m_Files)
+        s_LoadCache.m_Files.erase(file);
+    s_LoadCache.m_Order.erase(it->second.second);
+    s_LoadCache.m_Entries.erase(it);
+}
+
+static shared_ptr<const imgui_json::value> LoadCacheFind(uint64_t key, bool checkVersions)
+{
+    std::lock_guard<std::mutex> lock(s_LoadCache.m_Mutex);
+    auto it = s_LoadCache.m_Entries.find(key);
+    if (it == s_LoadCache.m_Entries.end())
+        return nullptr;
+    if (checkVersions && !TypeVersionsValid(it->second.first.m_Types))
+    {
+        LoadCacheErase(it);
+        return nullptr;
+    }
+    s_LoadCache.m_Order.splice(s_LoadCache.m_Order.begin(), s_LoadCache.m_Order, it->second.second);
+    return it->second.first.m_Value;
+}
+
+static shared_ptr<const imgui_json::value> LoadCacheFindFile(uint64_t fileKey)
+{
+    uint64_t key;
+    {
+        std::lock_guard<std::mutex> lock(s_LoadCache.m_Mutex);
+        auto it = s_LoadCache.m_Files.find(fileKey);
+        if (it == s_LoadCache.m_Files.end())
+            return nullptr;
+        key = it->second;
+    }
+    return LoadCacheFind(key, true);
+}
+
+static void LoadCacheInsert(uint64_t key, uint64_t fileKey, shared_ptr<const imgui_json::value> value)
+{
+    LoadCacheEntry entry;
+    entry.m_Value = value;
+    CollectTypeVersions(*value, entry.m_Types);
+
+    std::lock_guard<std::mutex> lock(s_LoadCache.m_Mutex);
+    auto it = s_LoadCache.m_Entries.find(key);
+    if (it == s_LoadCache.m_Entries.end())
+    {
+        s_LoadCache.m_Order.push_front(key);
+        it = s_LoadCache.m_Entries.emplace(key, std::make_pair(std::move(entry), s_LoadCache.m_Order.begin())).first;
+    }
+    if (fileKey && s_LoadCache.m_Files.emplace(fileKey, key).second)
+        it->second.first.m_Files.push_back(fileKey);
+    while (s_LoadCache.m_Entries.size() > s_LoadCache.m_Capacity && !s_LoadCache.m_Order.empty())
+        LoadCacheErase(s_LoadCache.m_Entries.find(s_LoadCache.m_Order.back()));
+}
+
+void BP::SetLoadCache(bool enable, size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(s_LoadCache.m_Mutex);
+    s_LoadCache.m_Enabled = enable;
+    s_LoadCache.m_Capacity = capacity > 0 ? capacity : 1;
+    if (!enable)
+    {
+        s_LoadCache.m_Entries.clear();
+        s_LoadCache.m_Order.clear();
+        s_LoadCache.m_Files.clear();
+    }
+}
+
+uint64_t BP::ContentHash(const imgui_json::value& value)
+{
+    // dump() of an object is key ordered, so formatting and key order of the file do not matter
+    uint64_t hash = OFFSET_64;
+    const imgui_json::array* nodeArray = nullptr;
+    if (!imgui_json::GetPtrTo(value, "nodes", nodeArray))
+        return hash;
+    auto registry = GetNodeRegistry();
+    for (auto& nodeValue : *nodeArray)
+    {
+        ID_TYPE typeId = 0;
+        imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId);
+        VERSION_TYPE versions[2] = {0, 0};
+        if (auto typeInfo = registry->GetTypeInfo(typeId))
+        {
+            versions[0] = typeInfo->m_Version;
+            versions[1] = typeInfo->m_SDK_Version;
+        }
+        hash = fnv1a_hash_64(&typeId, sizeof(typeId), hash);
+        hash = fnv1a_hash_64(versions, sizeof(versions), hash);
+        auto dump = nodeValue.dump();
+        hash = fnv1a_hash_64(dump.data(), dump.size(), hash);
+    }
+    return hash;
+}
+
 int BP::Load(std::string path)
 {
-    auto value = imgui_json::value::load(path);
-    if (!value.second)
+    bool cache_enabled;
+    {
+        std::lock_guard<std::mutex> lock(s_LoadCache.m_Mutex);
+        cache_enabled = s_LoadCache.m_Enabled;
+    }
+    if (!cache_enabled)
+    {
+        auto value = imgui_json::value::load(path);
+        if (!value.second)
+            return -1;
+
+        return Load(value.first);
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
         return -1;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    auto content = buffer.str();
+    auto fileKey = fnv1a_hash_64(content.data(), content.size());
+    if (auto cached = LoadCacheFindFile(fileKey))
+        return Load(*cached, true);
+
+    auto parsed = imgui_json::value::parse(content);
+    if (parsed.is_discarded())
+        return -1;
+    // same graph in another file (formatting, key order) still hits
+    auto key = ContentHash(parsed);
+    if (auto cached = LoadCacheFind(key, false))
+    {
+        int ret = Load(*cached, true);
+        if (ret == BP_ERR_NONE)
+            LoadCacheInsert(key, fileKey, cached);
+        return ret;
+    }
 
-    return Load(value.first);
+    int ret = Load(parsed);
+    if (ret == BP_ERR_NONE && m_TypeVerified)
+    {
+        auto loaded = make_shared<imgui_json::value>();
+        Save(*loaded);
+        LoadCacheInsert(key, fileKey, loaded);
+    }
+    return ret;
 }
 
 bool BP::Save(std::string path) const
@@ -639,11 +994,25 @@ ID_TYPE BP::MakeNodeID(Node* node)
 
 ID_TYPE BP::MakePinID(Pin* pin)
 {
-    if (pin) m_Pins.push_back(pin);
+    if (pin)
+    {
+        StopPrefetch();
+        m_Pins.push_back(pin);
+    }
+    {
+        // a new flow pin may turn its node into a branch
+        std::lock_guard<std::mutex> lock(m_ReplayableMutex);
+        m_Replayable.clear();
+    }
 
     return m_Generator.GenerateID();
 }
 
+ID_TYPE BP::MakeIDRange(ID_TYPE count)
+{
+    return m_Generator.GenerateIDRange(count);
+}
+
 Pin * BP::GetPinFromID(ID_TYPE pinid)
 {
     if (m_Pins.empty())
@@ -702,12 +1071,646 @@ vector<Pin*> BP::FindPinsLinkedTo(const Pin& pin) const
     return result;
 }
 
-void BP::ResetState()
+void BP::OnLinkChanged()
 {
-    m_Context.ResetState();
+    StopPrefetch();
+    m_TypeVerified = false;
+    {
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        m_Programs.clear();
+    }
+    DropNodeResults();
+    std::lock_guard<std::mutex> lock(m_FoldMutex);
+    m_FoldsDirty = true;
+}
+
+void BP::SetConstantFolding(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_FoldMutex);
+    m_ConstantFolding = enable;
+    m_Folds.clear();
+    m_FoldsDirty = true;
+}
+
+void BP::BuildFoldPlan()
+{
+    m_Folds.clear();
+    m_FoldsDirty = false;
+
+    // a pure node folds when every data input is unlinked or fed by a constant node or another
+    // foldable node, its leaves are the union of those sources. Entry points are never leaves, a
+    // host may hand in a new frame through the same buffer and nothing here could tell.
+    enum { Unknown, Visiting, Foldable, NotFoldable };
+    std::unordered_map<const Node*, int> state;
+    std::unordered_map<const Node*, std::vector<const Pin*>> leaves;
+    auto visit = [&](auto&& self, Node* node) -> bool
+    {
+        auto& nodeState = state[node];
+        if (nodeState == Visiting)
+            return false;
+        if (nodeState != Unknown)
+            return nodeState == Foldable;
+        if (!(node->GetCaps() & NODE_CAPS_PURE))
+        {
+            nodeState = NotFoldable;
+            return false;
+        }
+        nodeState = Visiting;
+
+        bool foldable = true;
+        std::vector<const Pin*> result;
+        for (auto pin : node->GetInputPins())
+        {
+            if (pin->GetType() == PinType::Flow)
+            {
+                foldable = false;
+                break;
+            }
+            auto provider = pin->GetLink(this);
+            if (!provider)
+            {
+                result.push_back(pin);
+                continue;
+            }
+            auto providerNode = provider->m_Node;
+            if (!providerNode)
+            {
+                foldable = false;
+                break;
+            }
+            if (providerNode->GetCaps() & NODE_CAPS_CONST)
+                result.push_back(provider);
+            else if (self(self, providerNode))
+            {
+                auto& sub = leaves[providerNode];
+                result.insert(result.end(), sub.begin(), sub.end());
+            }
+            else
+            {
+                foldable = false;
+                break;
+            }
+        }
+
+        state[node] = foldable ? Foldable : NotFoldable;
+        if (foldable)
+        {
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            leaves[node] = std::move(result);
+        }
+        return foldable;
+    };
+
+    for (auto node : m_Nodes)
+    {
+        if (!visit(visit, node))
+            continue;
+        for (auto pin : node->GetOutputPins())
+        {
+            if (pin->GetType() == PinType::Flow)
+                continue;
+            auto entry = std::make_shared<FoldEntry>();
+            entry->m_Leaves = leaves[node];
+            m_Folds[pin->m_ID] = std::move(entry);
+        }
+    }
+}
+
+bool BP::GetFoldedValue(const Context& context, const Pin& pin, PinValue& value, bool threading)
+{
+    // the entry is held by reference count, an edit on another thread may rebuild the plan meanwhile
+    std::shared_ptr<FoldEntry> entry;
+    {
+        std::lock_guard<std::mutex> lock(m_FoldMutex);
+        if (!m_ConstantFolding)
+            return false;
+        if (m_FoldsDirty)
+            BuildFoldPlan();
+        auto it = m_Folds.find(pin.m_ID);
+        if (it == m_Folds.end())
+            return false;
+        entry = it->second;
+    }
+
+    std::vector<PinValue> leafValues;
+    leafValues.reserve(entry->m_Leaves.size());
+    for (auto leaf : entry->m_Leaves)
+        leafValues.push_back(context.GetPinValue(*leaf, threading));
+
+    {
+        std::lock_guard<std::mutex> lock(m_FoldMutex);
+        bool same = entry->m_Valid;
+        for (size_t i = 0; same && i < leafValues.size(); i++)
+            same = leafValues[i].SameAs(entry->m_LeafValues[i]);
+        if (same)
+        {
+            value = entry->m_Value;
+            return true;
+        }
+    }
+
+    pin.m_Node->EnsureReset(const_cast<Context&>(context));
+    pin.m_Node->EnsurePreLoad();
+    auto result = pin.m_Node->EvaluatePin(context, pin, threading);
+    {
+        std::lock_guard<std::mutex> lock(m_FoldMutex);
+        entry->m_Value       = result;
+        entry->m_LeafValues  = std::move(leafValues);
+        entry->m_Valid       = true;
+    }
+    value = std::move(result);
+    return true;
+}
+
+void BP::SetIncremental(bool enable)
+{
+    m_Incremental = enable;
+    DropNodeResults();
+}
+
+void BP::DropNodeResults()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_ReplayableMutex);
+        m_Replayable.clear();
+    }
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    m_NodeResults.clear();
+    m_Readers.clear();
+    m_AlwaysDirty.clear();
+    m_ReadersValid = false;
+    m_EntryFingerprint = 0;
+}
+
+void BP::MarkNodeDirty(Node& node)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_CacheMutex);
+        m_NodeEdits[&node]++;
+    }
+    if (!m_Incremental)
+        return;
+    MarkDirtyFrom({ &node });
+}
 
+void BP::MarkDirtyFrom(std::vector<const Node*> dirty)
+{
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    if (!m_ReadersValid)
+        BuildReaders();
+
+    std::unordered_set<const Node*> visited(dirty.begin(), dirty.end());
+    for (size_t i = 0; i < dirty.size(); i++)
+    {
+        m_NodeResults.erase(dirty[i]);
+        auto it = m_Readers.find(dirty[i]);
+        if (it == m_Readers.end())
+            continue;
+        for (auto reader : it->second)
+        {
+            if (visited.insert(reader).second)
+                dirty.push_back(reader);
+        }
+    }
+}
+
+void BP::BuildReaders()
+{
+    m_Readers.clear();
+    m_AlwaysDirty.clear();
+    for (auto pin : m_Pins)
+    {
+        auto provider = pin->m_Node ? pin->GetLink(this) : nullptr;
+        if (provider && provider->m_Node && provider->m_Node != pin->m_Node)
+            m_Readers[provider->m_Node].push_back(pin->m_Node);
+    }
+
+    // nodes executed on every run (loops, branches, volatile and stateful data nodes) may hand
+    // their readers new values each time
     for (auto node : m_Nodes)
-        node->Reset(m_Context);
+    {
+        if (node->GetType() != NodeType::EntryPoint && !IsReplayable(*node) &&
+            !(node->GetCaps() & (NODE_CAPS_PURE | NODE_CAPS_CONST)))
+            m_AlwaysDirty.push_back(node);
+    }
+    m_ReadersValid = true;
+}
+
+bool BP::IsReplayable(Node& node) const
+{
+    // asked on every step, the answer only changes with the graph
+    std::lock_guard<std::mutex> lock(m_ReplayableMutex);
+    auto it = m_Replayable.find(&node);
+    if (it != m_Replayable.end())
+        return it->second;
+
+    bool replayable = false;
+    if (!IS_ENTRY_EXIT_NODE(node.GetType()) && !(node.GetCaps() & NODE_CAPS_VOLATILE))
+    {
+        // loops, branches and sequences pick their exit from state, only straight nodes can be replayed
+        int flowIn = 0, flowOut = 0;
+        for (auto pin : node.GetInputPins())
+            flowIn += pin->GetType() == PinType::Flow;
+        for (auto pin : node.GetOutputPins())
+            flowOut += pin->GetType() == PinType::Flow;
+        replayable = flowIn == 1 && flowOut == 1;
+    }
+    m_Replayable.emplace(&node, replayable);
+    return replayable;
+}
+
+void BP::UpdateEntryFingerprint(Node& entryPointNode)
+{
+    // the timestamp is part of it, nodes may read BP::GetTimeStamp
+    uint64_t fingerprint = fnv1a_hash_64(&entryPointNode.m_ID, sizeof(entryPointNode.m_ID));
+    fingerprint = fnv1a_hash_64(&m_TimeStamp, sizeof(m_TimeStamp), fingerprint);
+    fingerprint = fnv1a_hash_64(&m_Duration, sizeof(m_Duration), fingerprint);
+    // mats, arrays and custom payloads are handed in by the host, often decoded into the same or a
+    // recycled buffer, so their address says nothing about the content. Such an entry is new every run.
+    bool opaque = false;
+    for (auto pin : entryPointNode.GetOutputPins())
+    {
+        if (pin->GetType() == PinType::Flow)
+            continue;
+        auto value = pin->GetValue();
+        auto type = value.GetType();
+        if (type == PinType::Mat || type == PinType::Array || type == PinType::Custom || IsTypedArrayPinType(type))
+            opaque = true;
+        else
+            fingerprint = value.Hash(fingerprint);
+    }
+
+    std::vector<const Node*> dirty;
+    {
+        std::lock_guard<std::mutex> lock(m_ResultMutex);
+        m_Run++;
+        if (opaque || fingerprint != m_EntryFingerprint)
+            dirty.push_back(&entryPointNode);
+        m_EntryFingerprint = fingerprint;
+
+        if (!m_ReadersValid)
+            BuildReaders();
+        dirty.insert(dirty.end(), m_AlwaysDirty.begin(), m_AlwaysDirty.end());
+    }
+    if (!dirty.empty())
+        MarkDirtyFrom(std::move(dirty));
+}
+
+bool BP::ReuseNodeResult(const Node& node, FlowPin& next)
+{
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    auto it = m_NodeResults.find(&node);
+    // a node reached twice in one run executes again, it was not replayed the first time
+    if (it == m_NodeResults.end() || it->second.m_Run == m_Run)
+        return false;
+    next = it->second.m_Exit;
+    return true;
+}
+
+void BP::RecordNodeResult(Node& node, const FlowPin& next)
+{
+    if (!IsReplayable(node))
+        return;
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    m_NodeResults[&node] = { next, m_Run };
+}
+
+void BP::SetOutputCache(bool enable, size_t budget)
+{
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    m_OutputCache = enable;
+    m_CacheBudget = budget;
+    if (!enable)
+    {
+        m_CacheEntries.clear();
+        m_CacheIndex.clear();
+        m_CacheStats.m_Bytes = 0;
+        m_CacheStats.m_Entries = 0;
+    }
+}
+
+void BP::ClearOutputCache()
+{
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    m_CacheEntries.clear();
+    m_CacheIndex.clear();
+    m_NodeEdits.clear();
+    m_CacheStats = OutputCacheStats();
+}
+
+OutputCacheStats BP::GetOutputCacheStats() const
+{
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    return m_CacheStats;
+}
+
+bool BP::LookupCachedOutputs(Context& context, Node& node, FlowPin& next, OutputCacheProbe& probe, bool threading)
+{
+    probe = OutputCacheProbe();
+    if (!m_OutputCache || !IsReplayable(node))
+        return false;
+
+    uint64_t hash = fnv1a_hash_64(&node.m_ID, sizeof(node.m_ID));
+    {
+        std::lock_guard<std::mutex> lock(m_CacheMutex);
+        auto edits = m_NodeEdits.find(&node);
+        uint32_t edit = edits != m_NodeEdits.end() ? edits->second : 0;
+        hash = fnv1a_hash_64(&edit, sizeof(edit), hash);
+    }
+    bool state[2] = { node.m_Enabled, context.m_bypass_bg_node };
+    hash = fnv1a_hash_64(state, sizeof(state), hash);
+    if (node.GetCaps() & NODE_CAPS_TIME)
+    {
+        hash = fnv1a_hash_64(&m_TimeStamp, sizeof(m_TimeStamp), hash);
+        hash = fnv1a_hash_64(&m_Duration, sizeof(m_Duration), hash);
+    }
+    for (auto pin : node.GetInputPins())
+    {
+        if (pin->GetType() == PinType::Flow)
+            continue;
+        probe.m_Inputs.push_back(context.GetPinValue(*pin, threading));
+        hash = probe.m_Inputs.back().Hash(hash);
+    }
+    probe.m_Key = hash ? hash : 1;  // 0 means not cacheable
+
+    std::vector<std::pair<const Pin*, PinValue>> values;
+    bool hit = false;
+    {
+        std::lock_guard<std::mutex> lock(m_CacheMutex);
+        auto it = m_CacheIndex.find(probe.m_Key);
+        if (it != m_CacheIndex.end() && it->second->m_Node == &node && it->second->m_Inputs.size() == probe.m_Inputs.size())
+        {
+            hit = true;
+            for (size_t i = 0; hit && i < probe.m_Inputs.size(); i++)
+                hit = probe.m_Inputs[i].SameAs(it->second->m_Inputs[i]);
+        }
+        if (hit)
+        {
+            m_CacheEntries.splice(m_CacheEntries.begin(), m_CacheEntries, it->second);
+            m_CacheStats.m_Hits++;
+            values = it->second->m_Values;
+            next = it->second->m_Exit;
+        }
+        else
+            m_CacheStats.m_Misses++;
+    }
+    if (hit)
+    {
+        for (auto& value : values)
+            context.SetPinValue(*value.first, std::move(value.second));
+        return true;
+    }
+
+    // Execute reads the same inputs next, hand it the values evaluated above
+    size_t index = 0;
+    for (auto pin : node.GetInputPins())
+    {
+        if (pin->GetType() == PinType::Flow)
+            continue;
+        if (!context.GetPinValueRef(*pin))
+        {
+            context.SetPinValue(*pin, probe.m_Inputs[index]);
+            probe.m_Seeded.push_back(pin);
+        }
+        index++;
+    }
+    return false;
+}
+
+void BP::StoreCachedOutputs(Context& context, Node& node, OutputCacheProbe&& probe, const FlowPin& next)
+{
+    // seeded inputs only lived for this Execute, a later visit in the same run evaluates them again
+    for (auto pin : probe.m_Seeded)
+        context.m_Values.erase(pin->m_ID);
+    if (!probe.m_Key)
+        return;
+
+    CachedOutputs entry;
+    entry.m_Key   = probe.m_Key;
+    entry.m_Node  = &node;
+    entry.m_Exit  = next;
+    entry.m_Bytes = sizeof(CachedOutputs);
+    for (auto& input : probe.m_Inputs)
+        entry.m_Bytes += input.ByteSize();
+    entry.m_Inputs = std::move(probe.m_Inputs);
+    for (auto pin : node.GetOutputPins())
+    {
+        if (pin->GetType() == PinType::Flow)
+            continue;
+        // outputs the node did not store are evaluated on demand anyway
+        auto valueIt = context.m_Values.find(pin->m_ID);
+        if (valueIt == context.m_Values.end())
+            continue;
+        entry.m_Bytes += valueIt->second.ByteSize();
+        entry.m_Values.emplace_back(pin, valueIt->second);
+    }
+
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    if (!m_OutputCache || entry.m_Bytes > m_CacheBudget)
+        return;
+    auto it = m_CacheIndex.find(entry.m_Key);
+    if (it != m_CacheIndex.end())
+    {
+        m_CacheStats.m_Bytes -= it->second->m_Bytes;
+        m_CacheEntries.erase(it->second);
+        m_CacheIndex.erase(it);
+    }
+    m_CacheStats.m_Bytes += entry.m_Bytes;
+    auto key = entry.m_Key;
+    m_CacheEntries.push_front(std::move(entry));
+    m_CacheIndex[key] = m_CacheEntries.begin();
+
+    while (m_CacheStats.m_Bytes > m_CacheBudget && !m_CacheEntries.empty())
+    {
+        auto& last = m_CacheEntries.back();
+        m_CacheStats.m_Bytes -= last.m_Bytes;
+        m_CacheStats.m_Evictions++;
+        m_CacheIndex.erase(last.m_Key);
+        m_CacheEntries.pop_back();
+    }
+    m_CacheStats.m_Entries = m_CacheEntries.size();
+}
+
+void BP::SetExprCompile(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_ProgramMutex);
+    m_ExprCompile = enable;
+    m_Programs.clear();
+}
+
+bool BP::GetCompiledValue(const Context& context, const Pin& pin, PinValue& value, bool threading)
+{
+    if (!pin.m_Node || !(pin.m_Node->GetCaps() & NODE_CAPS_EXPR))
+        return false;
+
+    std::shared_ptr<const ExprProgram> program;
+    {
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        if (!m_ExprCompile)
+            return false;
+        auto it = m_Programs.find(pin.m_ID);
+        if (it == m_Programs.end())
+        {
+            auto compiled = std::make_shared<ExprProgram>();
+            if (!ExprCompiler(this).Compile(pin, *compiled))
+                compiled.reset();
+            it = m_Programs.emplace(pin.m_ID, std::move(compiled)).first;
+        }
+        program = it->second;
+    }
+    return program && program->Run(context, value, threading);
+}
+
+int BP::InferTypes()
+{
+    m_TypeMismatches.clear();
+    {
+        // node types may change below, programs were lowered for the old ones
+        std::lock_guard<std::mutex> lock(m_ProgramMutex);
+        m_Programs.clear();
+    }
+
+    // Inner pins of AnyPin come and go while types change, but they are never linked,
+    // so the set of linked pins stays valid through the whole pass. Providers are looked
+    // up once through an ID map, a GetPinFromID scan per link made loading and importing
+    // large graphs quadratic.
+    std::unordered_map<ID_TYPE, Pin*> pinsByID;
+    pinsByID.reserve(m_Pins.size());
+    for (auto pin : m_Pins)
+        pinsByID.emplace(pin->m_ID, pin);
+    std::vector<std::pair<Pin*, Pin*>> linked; // receiver, provider
+    for (auto pin : m_Pins)
+    {
+        if (!pin->m_Link || !pin->m_Node)
+            continue;
+        auto it = pinsByID.find(pin->m_Link);
+        if (it != pinsByID.end() && it->second->m_Node)
+            linked.emplace_back(pin, it->second);
+    }
+
+    // Push concrete types across links until nothing changes, each round resolves at least
+    // one more step along the longest chain so node count bounds the number of rounds
+    bool changed = true;
+    for (size_t round = 0; changed && round <= m_Nodes.size(); round++)
+    {
+        changed = false;
+        for (auto& link : linked)
+        {
+            auto pin = link.first;
+            auto provider = link.second;
+            auto receiverType = pin->GetValueType();
+            auto providerType = provider->GetValueType();
+            if (receiverType == providerType)
+                continue;
+            if (pin->GetType() == PinType::Any && providerType != PinType::Any)
+            {
+                pin->m_Node->WasLinked(*pin, *provider);
+                changed |= pin->GetValueType() != receiverType;
+            }
+            else if (provider->GetType() == PinType::Any && providerType == PinType::Any && receiverType != PinType::Any)
+            {
+                provider->m_Node->WasLinked(*pin, *provider);
+                changed |= provider->GetValueType() != providerType;
+            }
+        }
+    }
+
+    for (auto& link : linked)
+    {
+        auto pin = link.first;
+        auto provider = link.second;
+        auto actual = provider->GetValueType();
+        if (pin->m_Node->AcceptValueType(*pin, actual))
+            continue;
+        TypeMismatch mismatch;
+        mismatch.m_Receiver = pin->m_ID;
+        mismatch.m_Provider = provider->m_ID;
+        mismatch.m_Expected = pin->GetValueType();
+        mismatch.m_Actual   = actual;
+        m_TypeMismatches.push_back(mismatch);
+    }
+
+    m_TypeVerified = m_TypeMismatches.empty();
+    return m_TypeVerified ? BP_ERR_NONE : BP_ERR_PIN_TYPE;
+}
+
+void BP::Prefetch(Node& entryPointNode)
+{
+    StopPrefetch();
+    if (!m_LazyPreLoad)
+        return;
+
+    m_PrefetchCancel = false;
+    m_PrefetchThread = new std::thread([this](Node* entry)
+    {
+        std::vector<Node*> queue;
+        std::vector<ID_TYPE> visited;
+        queue.push_back(entry);
+        visited.push_back(entry->m_ID);
+        auto visit = [&](const Pin* pin)
+        {
+            if (!pin || !pin->m_Node || !pin->m_Node->m_Enabled)
+                return;
+            if (std::find(visited.begin(), visited.end(), pin->m_Node->m_ID) != visited.end())
+                return;
+            visited.push_back(pin->m_Node->m_ID);
+            queue.push_back(pin->m_Node);
+        };
+        for (size_t i = 0; i < queue.size() && !m_PrefetchCancel; i++)
+        {
+            auto node = queue[i];
+            node->EnsurePreLoad();
+            for (auto pins : { node->GetInputPins(), node->GetOutputPins() })
+            {
+                for (auto pin : pins)
+                {
+                    visit(pin->GetLink(this));
+                    for (auto id : pin->m_LinkFrom)
+                        visit(GetPinFromID(id));
+                }
+            }
+        }
+    }, &entryPointNode);
+}
+
+void BP::StopPrefetch()
+{
+    // a node preloading on the prefetch thread may create pins, it cannot wait for itself
+    if (!m_PrefetchThread || m_PrefetchThread->get_id() == std::this_thread::get_id())
+        return;
+    m_PrefetchCancel = true;
+    if (m_PrefetchThread->joinable())
+        m_PrefetchThread->join();
+    delete m_PrefetchThread;
+    m_PrefetchThread = nullptr;
+}
+
+void BP::ResetState()
+{
+    if (m_Incremental)
+    {
+        // clean nodes keep their values and state from the previous run, dirty ones start over
+        std::vector<Node*> dirty;
+        {
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            for (auto node : m_Nodes)
+            {
+                if (!m_NodeResults.count(node))
+                    dirty.push_back(node);
+            }
+        }
+        for (auto node : dirty)
+        {
+            for (auto pin : node->GetOutputPins())
+                m_Context.m_Values.erase(pin->m_ID);
+            node->m_ResetEpoch = 0;    // reset again when the executor reaches it
+        }
+        return;
+    }
+
+    // nodes reset themselves when the executor first reaches them in this run, see Node::EnsureReset
+    m_Context.ResetState();
 }
 # pragma endregion
 
@@ -1195,7 +1195,7 @@ struct GroupNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         auto& inputPinsValue = value["input_shadow_pins"]; // optional
@@ -1203,7 +1203,7 @@ struct GroupNode final : Node
         {
             imgui_json::value pinValue;
             pin->Save(pinValue, MapID);
-            inputPinsValue.push_back(pinValue);
+            inputPinsValue.push_back(std::move(pinValue));
         }
         if (inputPinsValue.is_null())
             value.erase("input_shadow_pins");
@@ -1213,28 +1213,28 @@ struct GroupNode final : Node
         {
             imgui_json::value pinValue;
             pin->Save(pinValue, MapID);
-            outputPinsValue.push_back(pinValue);
+            outputPinsValue.push_back(std::move(pinValue));
         }
         if (outputPinsValue.is_null())
             value.erase("output_shadow_pins");
     }
 
-    inline void SetPinIDToMap(Pin * pin, std::map<ID_TYPE, ID_TYPE>& MapID, ID_TYPE &index)
+    inline void SetPinIDToMap(Pin * pin, IDMap& MapID, ID_TYPE &index)
     {
-        MapID[pin->m_ID] = index++;
+        MapID.Set(pin->m_ID, index++);
         if (pin->GetType() == PinType::Any)
         {
             AnyPin * apin = (AnyPin *)pin;
             if (apin->m_InnerPin)
             {
-                MapID[apin->m_InnerPin->m_ID] = index++;
+                MapID.Set(apin->m_InnerPin->m_ID, index++);
             }
         }
     }
 
-    inline void SetNodeIDToMap(Node * node, std::map<ID_TYPE, ID_TYPE>& MapID, ID_TYPE &index)
+    inline void SetNodeIDToMap(Node * node, IDMap& MapID, ID_TYPE &index)
     {
-        MapID[node->m_ID] = index++;
+        MapID.Set(node->m_ID, index++);
     }
 
     void SaveGroup(std::string path_name)
@@ -1242,7 +1242,8 @@ struct GroupNode final : Node
         imgui_json::value result;
         // Create ID Map
         ID_TYPE object_id = 1;
-        std::map<ID_TYPE, ID_TYPE> IDMaps;
+        IDMap IDMaps;
+        IDMaps.Reserve(1 + m_InputBridgePins.size() + m_OutputBridgePins.size() + m_InputShadowPins.size() + m_OutputShadowPins.size() + m_GroupNodes.size() * 4);
         SetNodeIDToMap(this, IDMaps, object_id);
         for (auto pin : m_InputBridgePins)
         {
@@ -1272,6 +1273,7 @@ struct GroupNode final : Node
                 SetPinIDToMap(pin, IDMaps, object_id);
             }
         }
+        IDMaps.Build();
 
         // save group node
         imgui_json::value group_value;
@@ -1283,13 +1285,15 @@ struct GroupNode final : Node
         // save groupped nodes
         auto& nodesValue = result["nodes"];
         nodesValue = imgui_json::array();
+        nodesValue.get<imgui_json::array>().reserve(m_GroupNodes.size());
         for (auto node : m_GroupNodes)
         {
             imgui_json::value nodeValue;
-            nodeValue["type_id"] = imgui_json::number(node->GetTypeInfo().m_ID);
-            nodeValue["type_name"] = node->GetTypeInfo().m_Name;
+            auto typeInfo = node->GetTypeInfo();
+            nodeValue["type_id"] = imgui_json::number(typeInfo.m_ID);
+            nodeValue["type_name"] = typeInfo.m_Name;
             node->Save(nodeValue, IDMaps);
-            nodesValue.push_back(nodeValue);
+            nodesValue.push_back(std::move(nodeValue));
         }
 
         // save group node status and set location to 0,0
@@ -1298,7 +1302,7 @@ struct GroupNode final : Node
         ImVec2 group_location;
         edd::Serialization::Parse(GroupStatus["location"], group_location);
         GroupStatus["location"] = edd::Serialization::ToJson(ImVec2(0, 0));
-        nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.at(m_ID)))] = GroupStatus;
+        nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.Get(m_ID)))] = GroupStatus;
 
         // save all nodes status and modify location
         for (auto node : m_GroupNodes)
@@ -1308,25 +1312,55 @@ struct GroupNode final : Node
             edd::Serialization::Parse(nodeStatus["location"], node_location);
             node_location -= group_location;
             nodeStatus["location"] = edd::Serialization::ToJson(node_location);
-            nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.at(node->m_ID)))] = nodeStatus;
+            nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.Get(node->m_ID)))] = nodeStatus;
         }
         result.save(path_name);
     }
 
-    inline void GetPinIDMap(const imgui_json::value& pinValue, std::map<ID_TYPE, ID_TYPE>& IDMaps)
+    inline void GetPinIDMap(const imgui_json::value& pinValue, IDMap& IDMaps, ID_TYPE& next_id)
     {
         ID_TYPE object_id;
         imgui_json::GetTo<imgui_json::number>(pinValue, "id", object_id);
-        IDMaps[object_id] = m_Blueprint->MakePinID(nullptr);
+        IDMaps.Set(object_id, next_id++);
         if (pinValue.contains("inner"))
         {
-            auto innerValue = pinValue["inner"];
+            auto& innerValue = pinValue["inner"];
             imgui_json::GetTo<imgui_json::number>(innerValue, "id", object_id);
-            IDMaps[object_id] = m_Blueprint->MakePinID(nullptr);
+            IDMaps.Set(object_id, next_id++);
         }
     }
 
-    inline void AdjestPinID(Pin * pin, std::map<ID_TYPE, ID_TYPE>& IDMaps)
+    inline void GetPinArraysIDMap(const imgui_json::value& ownerValue, std::initializer_list<const char*> names, IDMap& IDMaps, ID_TYPE& next_id)
+    {
+        for (auto name : names)
+        {
+            const imgui_json::array* pinsArray = nullptr;
+            if (!imgui_json::GetPtrTo(ownerValue, name, pinsArray))
+                continue;
+            for (auto& pinValue : *pinsArray)
+            {
+                GetPinIDMap(pinValue, IDMaps, next_id);
+            }
+        }
+    }
+
+    inline ID_TYPE CountPinIDs(const imgui_json::value& ownerValue, std::initializer_list<const char*> names)
+    {
+        ID_TYPE count = 0;
+        for (auto name : names)
+        {
+            const imgui_json::array* pinsArray = nullptr;
+            if (!imgui_json::GetPtrTo(ownerValue, name, pinsArray))
+                continue;
+            for (auto& pinValue : *pinsArray)
+            {
+                count += pinValue.contains("inner") ? 2 : 1;
+            }
+        }
+        return count;
+    }
+
+    inline void AdjestPinID(Pin * pin, const IDMap& IDMaps)
     {
         pin->m_ID = GetIDFromMap(pin->m_ID, IDMaps);
         if (pin->m_MappedPin) pin->m_MappedPin = GetIDFromMap(pin->m_MappedPin, IDMaps);
@@ -1347,71 +1381,41 @@ struct GroupNode final : Node
 
     void LoadGroup(const imgui_json::value& value, ImVec2 pos)
     {
-        // rebuild ID Maps
-        std::map<ID_TYPE, ID_TYPE> IDMaps;
+        // rebuild ID Maps, count saved IDs first and take them as one contiguous range.
+        // SaveGroup numbers IDs in the same order as walked here, so the map is built
+        // already sorted and Build() is a no-op.
+        IDMap IDMaps;
         auto& groupValue = value["group"];
         auto& statusValue = value["status"];
-        ID_TYPE object_id;
-        imgui_json::GetTo<imgui_json::number>(groupValue, "id", object_id);
-        IDMaps[object_id] = m_ID;
-        const imgui_json::array* inputPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "input_pins", inputPinsArray))
-        {
-            for (auto& pinValue : *inputPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* outputPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "output_pins", outputPinsArray))
-        {
-            for (auto& pinValue : *outputPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* inputShadowPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "input_shadow_pins", inputShadowPinsArray)) // optional
-        {
-            for (auto& pinValue : *inputShadowPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* outputShadowPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "output_shadow_pins", outputShadowPinsArray)) // optional
+        const std::initializer_list<const char*> groupPins = { "input_pins", "output_pins", "input_shadow_pins", "output_shadow_pins" };
+        const std::initializer_list<const char*> nodePins = { "input_pins", "output_pins" };
+        const imgui_json::array* nodeArray = nullptr;
+        imgui_json::GetPtrTo(value, "nodes", nodeArray);
+        ID_TYPE id_count = CountPinIDs(groupValue, groupPins);
+        if (nodeArray)
         {
-            for (auto& pinValue : *outputShadowPinsArray)
+            for (auto& nodeValue : *nodeArray)
             {
-                GetPinIDMap(pinValue, IDMaps);
+                id_count += 1 + CountPinIDs(nodeValue, nodePins);
             }
         }
+        ID_TYPE next_id = m_Blueprint->MakeIDRange(id_count);
+        IDMaps.Reserve(id_count + 1);
 
-        const imgui_json::array* nodeArray = nullptr;
-        if (imgui_json::GetPtrTo(value, "nodes", nodeArray))
+        ID_TYPE object_id;
+        imgui_json::GetTo<imgui_json::number>(groupValue, "id", object_id);
+        IDMaps.Set(object_id, m_ID);
+        GetPinArraysIDMap(groupValue, groupPins, IDMaps, next_id);
+        if (nodeArray)
         {
             for (auto& nodeValue : *nodeArray)
             {
                 imgui_json::GetTo<imgui_json::number>(nodeValue, "id", object_id);
-                IDMaps[object_id] = m_Blueprint->MakeNodeID(nullptr);
-                const imgui_json::array* nodeInputPinsArray = nullptr;
-                if (imgui_json::GetPtrTo(nodeValue, "input_pins", nodeInputPinsArray))
-                {
-                    for (auto& pinValue : *nodeInputPinsArray)
-                    {
-                        GetPinIDMap(pinValue, IDMaps);
-                    }
-                }
-                const imgui_json::array* nodeOutputPinsArray = nullptr;
-                if (imgui_json::GetPtrTo(nodeValue, "output_pins", nodeOutputPinsArray))
-                {
-                    for (auto& pinValue : *nodeOutputPinsArray)
-                    {
-                        GetPinIDMap(pinValue, IDMaps);
-                    }
-                }
+                IDMaps.Set(object_id, next_id++);
+                GetPinArraysIDMap(nodeValue, nodePins, IDMaps, next_id);
             }
         }
+        IDMaps.Build();
         // Load Group Value
         Load(groupValue);
         auto GroupStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(m_ID))];
@@ -1445,10 +1449,10 @@ struct GroupNode final : Node
         ed::SetGroupSize(m_ID, group_size);
 
         // Create Group In-Nodes
-        const imgui_json::array* groupNodeArray = nullptr;
-        if (imgui_json::GetPtrTo(value, "nodes", groupNodeArray))
+        if (nodeArray)
         {
-            for (auto& nodeValue : *groupNodeArray)
+            m_GroupNodes.reserve(m_GroupNodes.size() + nodeArray->size());
+            for (auto& nodeValue : *nodeArray)
             {
                 ID_TYPE typeId;
                 if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId))
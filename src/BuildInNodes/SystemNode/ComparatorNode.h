@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include <SystemNode/TypedEvaluator.h>
 
 enum CompareType : int32_t
 {
@@ -19,73 +20,34 @@ struct ComparatorNode final : Node
 
     ComparatorNode(BP* blueprint): Node(blueprint) { m_Name = "Comparator"; m_HasCustomLayout = true; }
 
-    int ComparePinValue(PinValue& a, PinValue& b)
+    int ComparePinValue(const PinValue& a, const PinValue& b) const
     {
-        switch (m_Type)
-        {
-            case PinType::Int32:
-                if (a.As<int32_t>() > b.As<int32_t>())
-                    return 1;
-                else if (a.As<int32_t>() < b.As<int32_t>())
-                    return -1;
-                else
-                    return 0;
-            case PinType::Int64:
-                if (a.As<int64_t>() > b.As<int64_t>())
-                    return 1;
-                else if (a.As<int64_t>() < b.As<int64_t>())
-                    return -1;
-                else
-                    return 0;
-            case PinType::Float:
-                if (a.As<float>() > b.As<float>())
-                    return 1;
-                else if (a.As<float>() < b.As<float>())
-                    return -1;
-                else
-                    return 0;
-            case PinType::Double:
-                if (a.As<double>() > b.As<double>())
-                    return 1;
-                else if (a.As<double>() < b.As<double>())
-                    return -1;
-                else
-                    return 0;
-            case PinType::String:
-                return a.As<string>().compare(b.As<string>());
-            case PinType::Bool:
-                if (a.As<bool>() == b.As<bool>())
-                    return 0;
-                else if (a.As<bool>() == true)
-                    return 1;
-                else
-                    return -1;
-            default:
-                break;
-        }
-        return -2;
+        return m_Evaluator(a, b);
     }
 
     FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
     {
-        auto aValue = context.GetPinValue(m_A);
-        auto bValue = context.GetPinValue(m_B);
-        if (aValue.GetType() != m_Type ||
-            bValue.GetType() != m_Type)
-        {
-            return m_False; // Error: Node values must be of same type
-        }
+        auto result = ComparePinValue(context.GetPinValue(m_A), context.GetPinValue(m_B));
+        if (result == -2)
+            return m_False; // Error: Node values must be of same supported type
+        bool match = false;
         switch (m_CompareType)
         {
-            case Equal:        if (ComparePinValue(aValue, bValue) == 0) return m_True;
-            case Greater:      if (ComparePinValue(aValue, bValue) == 1) return m_True;
-            case Less:         if (ComparePinValue(aValue, bValue) == -1) return m_True;
-            case GreaterEqual: if ((ComparePinValue(aValue, bValue) == 0) || (ComparePinValue(aValue, bValue) == 1)) return m_True;
-            case LessEqual:    if ((ComparePinValue(aValue, bValue) == 0) || (ComparePinValue(aValue, bValue) == -1)) return m_True;
-            case NotEqual:     if ((ComparePinValue(aValue, bValue) != 0) && (ComparePinValue(aValue, bValue) != -2)) return m_True;
+            case Equal:        match = result == 0; break;
+            case Greater:      match = result == 1; break;
+            case Less:         match = result == -1; break;
+            case GreaterEqual: match = result >= 0; break;
+            case LessEqual:    match = result <= 0; break;
+            case NotEqual:     match = result != 0; break;
             default: break;
         }
-        return m_False;
+        return match ? m_True : m_False;
+    }
+
+    void WasLinked(const Pin& receiver, const Pin& provider) override
+    {
+        if (receiver.m_ID == m_A.m_ID || receiver.m_ID == m_B.m_ID)
+            SetType(provider.GetValueType());
     }
 
     bool DrawSettingLayout(ImGuiContext * ctx) override
@@ -156,7 +118,7 @@ struct ComparatorNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Type);
@@ -173,6 +135,7 @@ struct ComparatorNode final : Node
         m_A.SetValueType(type);
         m_B.SetValueType(type);
 
+        m_Evaluator = Typed::SelectCompare(type);
         m_Type = type;
     }
 
@@ -194,6 +157,7 @@ struct ComparatorNode final : Node
 private:
     PinType m_PendingType = PinType::Any;
     CompareType m_CompareType = Equal;
+    Typed::CompareEvaluator m_Evaluator = &Typed::UnsupportedCompare;
 
 };
 } // namespace BluePrint
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include <SystemNode/TypedEvaluator.h>
 #if IMGUI_ICONS
 #define ICON_CMP_SYMBOL "\u2268"
 #else
@@ -12,61 +13,30 @@ struct CompareNode final : Node
     BP_NODE(CompareNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic")
     CompareNode(BP* blueprint): Node(blueprint) { SetType(PinType::Any); }
 
+    static constexpr bool IsPure = true;
+
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
         {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
-                return {}; // Error: Node values must be of same type
-            }
-
-            switch (m_Type)
-            {
-                case PinType::Int32:
-                    if (aValue.As<int32_t>() > bValue.As<int32_t>())
-                        return 1;
-                    else if (aValue.As<int32_t>() < bValue.As<int32_t>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Int64:
-                    if (aValue.As<int64_t>() > bValue.As<int64_t>())
-                        return 1;
-                    else if (aValue.As<int64_t>() < bValue.As<int64_t>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Float:
-                    if (aValue.As<float>() > bValue.As<float>())
-                        return 1;
-                    else if (aValue.As<float>() < bValue.As<float>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Double:
-                    if (aValue.As<double>() > bValue.As<double>())
-                        return 1;
-                    else if (aValue.As<double>() < bValue.As<double>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::String:
-                    return aValue.As<string>().compare(bValue.As<string>());
-                default:
-                    break;
-            }
-
-            return {}; // Error: Unsupported type
+            auto result = m_Evaluator(context.GetPinValue(m_A), context.GetPinValue(m_B));
+            if (result == -2)
+                return {}; // Error: Node values must be of same supported type
+            return result;
         }
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    static constexpr bool HasCompileExpr = true;
+    int CompileExpr(ExprCompiler& compiler, const Pin& output) const override
+    {
+        ExprType type;
+        if (output.m_ID != m_Result.m_ID || !ExprTypeFromPinType(m_Type, type))
+            return -1;
+        return compiler.Emit(ExprOp::Compare, type, compiler.Input(m_A, type), compiler.Input(m_B, type));
+    }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -146,7 +116,7 @@ struct CompareNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Type);
@@ -162,6 +132,7 @@ struct CompareNode final : Node
         m_A.SetValueType(type);
         m_B.SetValueType(type);
 
+        m_Evaluator = Typed::SelectCompare(type);
         m_Type = type;
     }
 
@@ -181,6 +152,7 @@ struct CompareNode final : Node
 
 private:
     PinType m_PendingType = PinType::Any;
+    Typed::CompareEvaluator m_Evaluator = &Typed::UnsupportedCompare;
 
 };
 } // namespace BluePrint
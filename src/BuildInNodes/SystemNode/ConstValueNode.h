@@ -13,6 +13,8 @@ struct ConstValueNode final : Node
         m_HasCustomLayout = true;
     }
 
+    static constexpr bool IsConstant = true;
+
     bool DrawSettingLayout(ImGuiContext * ctx) override
     {
         // We don't set node name for this Node
@@ -181,7 +183,7 @@ struct ConstValueNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Value.GetValueType());
@@ -10,6 +10,8 @@ struct CountNode final : Node
 
     CountNode(BP* blueprint): Node(blueprint) { m_Name = "Count"; }
 
+    static constexpr bool IsVolatile = true;
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
@@ -71,7 +73,7 @@ struct CountNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["accumulate"] = imgui_json::boolean(m_Accumulate);
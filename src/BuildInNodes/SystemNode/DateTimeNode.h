@@ -24,6 +24,9 @@ struct DateTimeNode final : Node
     BP_NODE(DateTimeNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
     DateTimeNode(BP* blueprint): Node(blueprint) { m_Name = "Date Time"; }
 
+    static constexpr bool IsVolatile = true;
+    static constexpr bool IsTimeDependent = true;
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
@@ -137,7 +140,7 @@ struct DateTimeNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["out_flags"] = imgui_json::number(m_out_flags);
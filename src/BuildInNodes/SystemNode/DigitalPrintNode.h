@@ -85,7 +85,7 @@ struct PrintNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) override
+    void Save(imgui_json::value& value, const IDMap& MapID) override
     {
         Node::Save(value, MapID);
         value["layout"] = m_print_to_layout;
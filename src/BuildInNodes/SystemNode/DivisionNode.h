@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include <SystemNode/TypedEvaluator.h>
 #if IMGUI_ICONS
 #define ICON_DIV_SYMBOL "\u29BC"
 #else
@@ -19,38 +20,26 @@ struct DivNode final : Node
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
-        {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
-                return {}; // Error: Node values must be of same type
-            }
-
-            switch (m_Type)
-            {
-                case PinType::Int32:
-                    if (bValue.As<int32_t>() == 0) return INT_MAX;
-                    return aValue.As<int32_t>() / bValue.As<int32_t>();
-                case PinType::Int64:
-                    if (bValue.As<int64_t>() == 0) return (int64_t)LLONG_MAX;
-                    return aValue.As<int64_t>() / bValue.As<int64_t>();
-                case PinType::Float:
-                    return aValue.As<float>() / (bValue.As<float>() + 1e-10f);
-                case PinType::Double:
-                    return aValue.As<double>() / (bValue.As<double>() + 1e-10f);
-                default:
-                    break;
-            }
-
-            return {}; // Error: Unsupported type
-        }
+            return Calculate(context.GetPinValue(m_A), context.GetPinValue(m_B));
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    static constexpr bool IsPure = true;
+    static constexpr bool HasCompileExpr = true;
+    int CompileExpr(ExprCompiler& compiler, const Pin& output) const override
+    {
+        ExprType type;
+        if (output.m_ID != m_Result.m_ID || !ExprTypeFromPinType(m_Type, type))
+            return -1;  // Mat and arrays stay on the element-wise kernels
+        return compiler.Emit(ExprOp::Div, type, compiler.Input(m_A, type), compiler.Input(m_B, type));
+    }
+
+    PinValue Calculate(const PinValue& aValue, const PinValue& bValue) const
+    {
+        return m_Evaluator(aValue, bValue);
+    }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -84,6 +73,10 @@ struct DivNode final : Node
                 case PinType::Int64:
                 case PinType::Float:
                 case PinType::Double:
+                case PinType::Mat:
+                case PinType::FloatArray:
+                case PinType::Int32Array:
+                case PinType::Vec4Array:
                     return { true, "Other pins will convert to this pin type" };
 
                 default:
@@ -100,7 +93,12 @@ struct DivNode final : Node
             return;
 
         if (receiver.m_ID == m_A.m_ID || receiver.m_ID == m_B.m_ID)
+        {
+            // a scalar operand next to a Mat or array is broadcast, keep the container type
+            if (ElementWise::IsContainerType(m_Type) && ElementWise::IsScalarType(provider.GetValueType()))
+                return;
             SetType(provider.GetValueType());
+        }
         else if (provider.m_ID == m_Result.m_ID)
             SetType(receiver.GetValueType());
     }
@@ -109,6 +107,14 @@ struct DivNode final : Node
     {
     }
 
+    bool AcceptValueType(const Pin& receiver, PinType type) const override
+    {
+        // scalar operands are broadcast over a Mat or array
+        if (ElementWise::IsContainerType(m_Type) && ElementWise::IsScalarType(type))
+            return true;
+        return Node::AcceptValueType(receiver, type);
+    }
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -131,7 +137,7 @@ struct DivNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Type);
@@ -148,6 +154,7 @@ struct DivNode final : Node
         m_B.SetValueType(type);
         m_Result.SetValueType(type);
 
+        m_Evaluator = Typed::SelectArithmetic<ElementWise::Op::Div>(type);
         m_Type = type;
     }
 
@@ -167,5 +174,6 @@ struct DivNode final : Node
 
 private:
     PinType m_PendingType = PinType::Any;
+    Typed::BinaryEvaluator m_Evaluator = &Typed::UnsupportedBinary;
 };
 } // namespace BluePrint
@@ -0,0 +1,378 @@
+#pragma once
+#include <imgui.h>
+#include <immat.h>
+#include <limits.h>
+#include <math.h>
+#include <limits>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+#include <immintrin.h>
+#define BP_ELEMENTWISE_AVX2         1
+#define BP_ELEMENTWISE_AVX2_RUNTIME 1
+#define BP_TARGET_AVX2              __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define BP_ELEMENTWISE_AVX2         1
+#define BP_TARGET_AVX2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BP_ELEMENTWISE_NEON         1
+#endif
+
+namespace BluePrint
+{
+// Element-wise arithmetic for the Add/Sub/Mul/Div nodes over ImMat and typed array operands.
+// Either operand may be a scalar number, which is broadcast over the other one. Kernels take a
+// stride per input, 1 walks the buffer and 0 repeats its first element.
+namespace ElementWise
+{
+enum class Op { Add, Sub, Mul, Div };
+
+inline bool IsContainerType(PinType type)
+{
+    return type == PinType::Mat || IsTypedArrayPinType(type);
+}
+
+inline bool IsScalarType(PinType type)
+{
+    return type == PinType::Int32 || type == PinType::Int64 || type == PinType::Float || type == PinType::Double;
+}
+
+inline bool HasAVX2()
+{
+#if BP_ELEMENTWISE_AVX2_RUNTIME
+    static const bool s_HasAVX2 = __builtin_cpu_supports("avx2");
+    return s_HasAVX2;
+#elif BP_ELEMENTWISE_AVX2
+    return true;
+#else
+    return false;
+#endif
+}
+
+// -------[ Scalar ]-------
+template <Op op, typename T>
+inline T Apply(T a, T b)
+{
+    if constexpr (op == Op::Add) return a + b;
+    else if constexpr (op == Op::Sub) return a - b;
+    else if constexpr (op == Op::Mul) return a * b;
+    else if constexpr (std::is_floating_point<T>::value) return a / (b + T(1e-10));   // same guard as the scalar nodes
+    else return b == 0 ? std::numeric_limits<T>::max() : a / b;
+}
+
+// uint8 results saturate to [0, 255] like image arithmetic does
+template <Op op>
+inline uint8_t ApplyU8(uint8_t a, uint8_t b)
+{
+    int r;
+    if constexpr (op == Op::Add) r = int(a) + int(b);
+    else if constexpr (op == Op::Sub) r = int(a) - int(b);
+    else if constexpr (op == Op::Mul) r = int(a) * int(b);
+    else r = b == 0 ? 255 : int(a) / int(b);
+    return (uint8_t)(r < 0 ? 0 : r > 255 ? 255 : r);
+}
+
+template <Op op, typename T>
+inline void LoopScalar(const T* a, size_t as, const T* b, size_t bs, T* out, size_t begin, size_t n)
+{
+    for (size_t i = begin; i < n; i++)
+        out[i] = Apply<op>(a[i * as], b[i * bs]);
+}
+
+template <Op op>
+inline void LoopScalarU8(const uint8_t* a, size_t as, const uint8_t* b, size_t bs, uint8_t* out, size_t begin, size_t n)
+{
+    for (size_t i = begin; i < n; i++)
+        out[i] = ApplyU8<op>(a[i * as], b[i * bs]);
+}
+
+// -------[ AVX2 ]-------
+#if BP_ELEMENTWISE_AVX2
+template <Op op>
+BP_TARGET_AVX2 inline void LoopAVX2(const float* a, size_t as, const float* b, size_t bs, float* out, size_t n)
+{
+    const __m256 ba = _mm256_set1_ps(a[0]);
+    const __m256 bb = _mm256_set1_ps(b[0]);
+    const __m256 eps = _mm256_set1_ps(1e-10f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 x = as ? _mm256_loadu_ps(a + i) : ba;
+        __m256 y = bs ? _mm256_loadu_ps(b + i) : bb;
+        __m256 r;
+        if constexpr (op == Op::Add) r = _mm256_add_ps(x, y);
+        else if constexpr (op == Op::Sub) r = _mm256_sub_ps(x, y);
+        else if constexpr (op == Op::Mul) r = _mm256_mul_ps(x, y);
+        else r = _mm256_div_ps(x, _mm256_add_ps(y, eps));
+        _mm256_storeu_ps(out + i, r);
+    }
+    LoopScalar<op>(a, as, b, bs, out, i, n);
+}
+
+template <Op op>
+BP_TARGET_AVX2 inline void LoopAVX2(const int32_t* a, size_t as, const int32_t* b, size_t bs, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    if constexpr (op != Op::Div)
+    {
+        const __m256i ba = _mm256_set1_epi32(a[0]);
+        const __m256i bb = _mm256_set1_epi32(b[0]);
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i x = as ? _mm256_loadu_si256((const __m256i*)(a + i)) : ba;
+            __m256i y = bs ? _mm256_loadu_si256((const __m256i*)(b + i)) : bb;
+            __m256i r;
+            if constexpr (op == Op::Add) r = _mm256_add_epi32(x, y);
+            else if constexpr (op == Op::Sub) r = _mm256_sub_epi32(x, y);
+            else r = _mm256_mullo_epi32(x, y);
+            _mm256_storeu_si256((__m256i*)(out + i), r);
+        }
+    }
+    LoopScalar<op>(a, as, b, bs, out, i, n);
+}
+
+template <Op op>
+BP_TARGET_AVX2 inline void LoopAVX2U8(const uint8_t* a, size_t as, const uint8_t* b, size_t bs, uint8_t* out, size_t n)
+{
+    size_t i = 0;
+    if constexpr (op == Op::Add || op == Op::Sub)
+    {
+        const __m256i ba = _mm256_set1_epi8((char)a[0]);
+        const __m256i bb = _mm256_set1_epi8((char)b[0]);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i x = as ? _mm256_loadu_si256((const __m256i*)(a + i)) : ba;
+            __m256i y = bs ? _mm256_loadu_si256((const __m256i*)(b + i)) : bb;
+            __m256i r = op == Op::Add ? _mm256_adds_epu8(x, y) : _mm256_subs_epu8(x, y);
+            _mm256_storeu_si256((__m256i*)(out + i), r);
+        }
+    }
+    LoopScalarU8<op>(a, as, b, bs, out, i, n);
+}
+#endif
+
+// -------[ NEON ]-------
+#if BP_ELEMENTWISE_NEON
+template <Op op>
+inline void LoopNEON(const float* a, size_t as, const float* b, size_t bs, float* out, size_t n)
+{
+    size_t i = 0;
+#if !defined(__aarch64__)
+    if constexpr (op != Op::Div) // armv7 has no vector divide
+#endif
+    {
+        const float32x4_t ba = vdupq_n_f32(a[0]);
+        const float32x4_t bb = vdupq_n_f32(b[0]);
+        for (; i + 4 <= n; i += 4)
+        {
+            float32x4_t x = as ? vld1q_f32(a + i) : ba;
+            float32x4_t y = bs ? vld1q_f32(b + i) : bb;
+            float32x4_t r;
+            if constexpr (op == Op::Add) r = vaddq_f32(x, y);
+            else if constexpr (op == Op::Sub) r = vsubq_f32(x, y);
+            else if constexpr (op == Op::Mul) r = vmulq_f32(x, y);
+#if defined(__aarch64__)
+            else r = vdivq_f32(x, vaddq_f32(y, vdupq_n_f32(1e-10f)));
+#endif
+            vst1q_f32(out + i, r);
+        }
+    }
+    LoopScalar<op>(a, as, b, bs, out, i, n);
+}
+
+template <Op op>
+inline void LoopNEON(const int32_t* a, size_t as, const int32_t* b, size_t bs, int32_t* out, size_t n)
+{
+    size_t i = 0;
+    if constexpr (op != Op::Div)
+    {
+        const int32x4_t ba = vdupq_n_s32(a[0]);
+        const int32x4_t bb = vdupq_n_s32(b[0]);
+        for (; i + 4 <= n; i += 4)
+        {
+            int32x4_t x = as ? vld1q_s32(a + i) : ba;
+            int32x4_t y = bs ? vld1q_s32(b + i) : bb;
+            int32x4_t r;
+            if constexpr (op == Op::Add) r = vaddq_s32(x, y);
+            else if constexpr (op == Op::Sub) r = vsubq_s32(x, y);
+            else r = vmulq_s32(x, y);
+            vst1q_s32(out + i, r);
+        }
+    }
+    LoopScalar<op>(a, as, b, bs, out, i, n);
+}
+
+template <Op op>
+inline void LoopNEONU8(const uint8_t* a, size_t as, const uint8_t* b, size_t bs, uint8_t* out, size_t n)
+{
+    size_t i = 0;
+    if constexpr (op == Op::Add || op == Op::Sub)
+    {
+        const uint8x16_t ba = vdupq_n_u8(a[0]);
+        const uint8x16_t bb = vdupq_n_u8(b[0]);
+        for (; i + 16 <= n; i += 16)
+        {
+            uint8x16_t x = as ? vld1q_u8(a + i) : ba;
+            uint8x16_t y = bs ? vld1q_u8(b + i) : bb;
+            vst1q_u8(out + i, op == Op::Add ? vqaddq_u8(x, y) : vqsubq_u8(x, y));
+        }
+    }
+    LoopScalarU8<op>(a, as, b, bs, out, i, n);
+}
+#endif
+
+// -------[ Dispatch ]-------
+template <Op op, typename T>
+inline void Run(const T* a, size_t as, const T* b, size_t bs, T* out, size_t n)
+{
+    if constexpr (std::is_same<T, uint8_t>::value)
+    {
+#if BP_ELEMENTWISE_AVX2
+        if (HasAVX2()) return LoopAVX2U8<op>(a, as, b, bs, out, n);
+#elif BP_ELEMENTWISE_NEON
+        return LoopNEONU8<op>(a, as, b, bs, out, n);
+#endif
+        return LoopScalarU8<op>(a, as, b, bs, out, 0, n);
+    }
+    else if constexpr (std::is_same<T, float>::value || std::is_same<T, int32_t>::value)
+    {
+#if BP_ELEMENTWISE_AVX2
+        if (HasAVX2()) return LoopAVX2<op>(a, as, b, bs, out, n);
+#elif BP_ELEMENTWISE_NEON
+        return LoopNEON<op>(a, as, b, bs, out, n);
+#endif
+        return LoopScalar<op>(a, as, b, bs, out, 0, n);
+    }
+    else
+        return LoopScalar<op>(a, as, b, bs, out, 0, n);
+}
+
+template <typename T>
+inline void Run(Op op, const T* a, size_t as, const T* b, size_t bs, T* out, size_t n)
+{
+    switch (op)
+    {
+        case Op::Add: Run<Op::Add>(a, as, b, bs, out, n); break;
+        case Op::Sub: Run<Op::Sub>(a, as, b, bs, out, n); break;
+        case Op::Mul: Run<Op::Mul>(a, as, b, bs, out, n); break;
+        case Op::Div: Run<Op::Div>(a, as, b, bs, out, n); break;
+    }
+}
+
+// -------[ PinValue ]-------
+template <typename T>
+inline bool ScalarAs(const PinValue& value, T& result)
+{
+    double v;
+    switch (value.GetType())
+    {
+        case PinType::Int32:  v = value.As<int32_t>(); break;
+        case PinType::Int64:  v = (double)value.As<int64_t>(); break;
+        case PinType::Float:  v = value.As<float>(); break;
+        case PinType::Double: v = value.As<double>(); break;
+        default: return false;
+    }
+    if constexpr (std::is_same<T, uint8_t>::value)
+        v = v < 0 ? 0 : v > 255 ? 255 : v;
+    result = (T)v;
+    return true;
+}
+
+template <typename T>
+inline PinValue CalculateArray(Op op, const PinValue& aValue, const PinValue& bValue, PinType type)
+{
+    // Vec4Array is processed as a flat float buffer, broadcasting a scalar to every component
+    using E = typename std::conditional<std::is_same<T, ImVec4>::value, float, T>::type;
+    constexpr size_t lanes = sizeof(T) / sizeof(E);
+    const PinArray<T>* a = aValue.GetType() == type ? &aValue.As<PinArray<T>>() : nullptr;
+    const PinArray<T>* b = bValue.GetType() == type ? &bValue.As<PinArray<T>>() : nullptr;
+    E sa {}, sb {};
+    if (!a && !ScalarAs(aValue, sa)) return {};
+    if (!b && !ScalarAs(bValue, sb)) return {};
+    if (a && b && a->size() != b->size()) return {};
+
+    PinArray<T> result(a ? a->size() : b->size());
+    Run(op, a ? (const E*)a->data() : &sa, a ? 1 : 0,
+            b ? (const E*)b->data() : &sb, b ? 1 : 0,
+            (E*)result.data(), result.size() * lanes);
+    return result;
+}
+
+template <typename T>
+inline void RunMat(Op op, const ImGui::ImMat* a, T sa, const ImGui::ImMat* b, T sb, ImGui::ImMat& out, size_t n)
+{
+    Run(op, a ? (const T*)a->data : &sa, a ? 1 : 0, b ? (const T*)b->data : &sb, b ? 1 : 0, (T*)out.data, n);
+}
+
+inline PinValue CalculateMat(Op op, const PinValue& aValue, const PinValue& bValue)
+{
+    const ImGui::ImMat* a = aValue.GetType() == PinType::Mat ? &aValue.As<ImGui::ImMat>() : nullptr;
+    const ImGui::ImMat* b = bValue.GetType() == PinType::Mat ? &bValue.As<ImGui::ImMat>() : nullptr;
+    const ImGui::ImMat& ref = a ? *a : *b;
+    if (ref.empty() || ref.device != IM_DD_CPU)
+        return {};
+    if (a && b && (b->empty() || b->device != IM_DD_CPU ||
+                   a->w != b->w || a->h != b->h || a->c != b->c ||
+                   a->type != b->type || a->elempack != b->elempack || a->total() != b->total()))
+        return {};
+
+    ImGui::ImMat out;
+    out.create_like(ref);
+    if (out.empty())
+        return {};
+    size_t n = ref.total() * ref.elempack;
+    switch (ref.type)
+    {
+        case IM_DT_INT8:
+        {
+            uint8_t sa = 0, sb = 0;
+            if ((!a && !ScalarAs(aValue, sa)) || (!b && !ScalarAs(bValue, sb))) return {};
+            RunMat(op, a, sa, b, sb, out, n);
+        }
+        break;
+        case IM_DT_INT32:
+        {
+            int32_t sa = 0, sb = 0;
+            if ((!a && !ScalarAs(aValue, sa)) || (!b && !ScalarAs(bValue, sb))) return {};
+            RunMat(op, a, sa, b, sb, out, n);
+        }
+        break;
+        case IM_DT_FLOAT32:
+        {
+            float sa = 0, sb = 0;
+            if ((!a && !ScalarAs(aValue, sa)) || (!b && !ScalarAs(bValue, sb))) return {};
+            RunMat(op, a, sa, b, sb, out, n);
+        }
+        break;
+        case IM_DT_FLOAT64:
+        {
+            double sa = 0, sb = 0;
+            if ((!a && !ScalarAs(aValue, sa)) || (!b && !ScalarAs(bValue, sb))) return {};
+            RunMat(op, a, sa, b, sb, out, n);
+        }
+        break;
+        default:
+            return {}; // Error: Unsupported mat data type
+    }
+    return out;
+}
+
+// Entry point for the arithmetic nodes, type is the node's data type (a container type)
+inline PinValue Calculate(Op op, const PinValue& aValue, const PinValue& bValue, PinType type)
+{
+    if (aValue.GetType() != type && bValue.GetType() != type)
+        return {}; // Error: at least one operand must be of the node type
+    switch (type)
+    {
+        case PinType::Mat:          return CalculateMat(op, aValue, bValue);
+        case PinType::FloatArray:   return CalculateArray<float>(op, aValue, bValue, type);
+        case PinType::Int32Array:   return CalculateArray<int32_t>(op, aValue, bValue, type);
+        case PinType::Vec4Array:    return CalculateArray<ImVec4>(op, aValue, bValue, type);
+        default:                    return {};
+    }
+}
+} // namespace ElementWise
+} // namespace BluePrint
@@ -9,6 +9,8 @@ struct FlipFlopNode final : Node
 
     FlipFlopNode(BP* blueprint): Node(blueprint) { m_Name = "Flip Flop"; }
 
+    static constexpr bool IsVolatile = true;
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
@@ -10,6 +10,8 @@ struct FloatCountNode final : Node
 
     FloatCountNode(BP* blueprint): Node(blueprint) { m_Name = "Float Count"; }
 
+    static constexpr bool IsVolatile = true;
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
@@ -72,7 +74,7 @@ struct FloatCountNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["accumulate"] = imgui_json::boolean(m_Accumulate);
@@ -13,35 +13,33 @@ struct SwitchNode final : Node
 
     SwitchNode(BP* blueprint) : Node(blueprint) { SetType(PinType::Any); }
 
+    static constexpr bool IsPure = true;
+
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
         {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-            auto cValue = context.GetPinValue(m_Condition);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
+            // only the selected input is evaluated
+            auto condition = context.GetPinValue(m_Condition);
+            auto selected = condition.TryAs<bool>();
+            auto value = context.GetPinValue(selected && *selected ? m_A : m_B);
+            if (!m_Blueprint->IsTypeVerified() && value.GetType() != m_Type)
                 return {}; // Error: Node values must be of same type
-            }
-
-            if (cValue.As<bool>())
-            {
-                return aValue;
-            }
-            else
-            {
-                return bValue;
-            }
-
-            return {}; // Error: Unsupported type
+            return value;
         }
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    static constexpr bool HasCompileExpr = true;
+    int CompileExpr(ExprCompiler& compiler, const Pin& output) const override
+    {
+        ExprType type;
+        if (output.m_ID != m_Result.m_ID || !ExprTypeFromPinType(m_Type, type))
+            return -1;
+        return compiler.Select(compiler.Input(m_Condition, ExprType::Bool), m_A, m_B, type);
+    }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -125,7 +123,7 @@ struct SwitchNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Type);
@@ -6,6 +6,9 @@ struct TimerNode final : Node
 {
     BP_NODE(TimerNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
     TimerNode(BP* blueprint): Node(blueprint) { m_Name = "Timer"; }
+
+    static constexpr bool IsVolatile = true;
+    static constexpr bool IsTimeDependent = true;
     
     void Reset(Context& context) override
     {
@@ -99,7 +102,7 @@ struct TimerNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["interval"]   = imgui_json::number(m_interval_ms);
@@ -89,6 +89,29 @@ struct ToStringNode final : Node
             break;
             case PinType::String: result = value.As<string>(); break;
             case PinType::Point:  break;
+            case PinType::Array:  result = imgui_json::value(value.As<imgui_json::array>()).dump(); break;
+            case PinType::FloatArray:
+            {
+                string format = m_floating_decimal > 0 ? "%." + std::to_string(m_floating_decimal) + "f" : "%f";
+                result = FormatArray(value.As<FloatArray>(), [&](char* buffer, float v) { snprintf(buffer, 128, format.c_str(), v); });
+            }
+            break;
+            case PinType::Int32Array:
+                result = FormatArray(value.As<Int32Array>(), [&](char* buffer, int32_t v)
+                {
+                    if (m_format_type == FORMAT_TYPE_HEX)
+                        snprintf(buffer, 128, "0x%08X", v);
+                    else
+                        snprintf(buffer, 128, m_format_type == FORMAT_TYPE_UNSIGNED ? "%u" : "%d", v);
+                });
+            break;
+            case PinType::Vec4Array:
+            {
+                string format = m_floating_decimal > 0 ? "%." + std::to_string(m_floating_decimal) + "f" : "%f";
+                format = "(" + format + ", " + format + ", " + format + ", " + format + ")";
+                result = FormatArray(value.As<Vec4Array>(), [&](char* buffer, const ImVec4& v) { snprintf(buffer, 128, format.c_str(), v.x, v.y, v.z, v.w); });
+            }
+            break;
             default:              break;
         }
 
@@ -97,6 +120,20 @@ struct ToStringNode final : Node
         return m_Exit;
     }
 
+    template <typename T, typename F>
+    static string FormatArray(const PinArray<T>& array, F&& format)
+    {
+        string result = "[";
+        char buffer[128] = {0};
+        for (size_t i = 0; i < array.size(); i++)
+        {
+            format(buffer, array[i]);
+            if (i > 0) result += ", ";
+            result += buffer;
+        }
+        return result + "]";
+    }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -123,8 +160,15 @@ struct ToStringNode final : Node
                 changed |= ImGui::RadioButton("Unsigned", &m_format_type, FORMAT_TYPE_UNSIGNED);
                 if (m_format_type != FORMAT_TYPE_HEX) changed |= ImGui::InputInt("Max Zero Prefix", &m_zero_count);
             break;
+            case PinType::Int32Array:
+                changed |= ImGui::RadioButton("Decimal", &m_format_type, FORMAT_TYPE_NONE); ImGui::SameLine();
+                changed |= ImGui::RadioButton("Hex", &m_format_type, FORMAT_TYPE_HEX); ImGui::SameLine();
+                changed |= ImGui::RadioButton("Unsigned", &m_format_type, FORMAT_TYPE_UNSIGNED);
+            break;
             case PinType::Float:
             case PinType::Double:
+            case PinType::FloatArray:
+            case PinType::Vec4Array:
                 changed |= ImGui::InputInt("Floating decimal", &m_floating_decimal);
             break;
             default:              break;
@@ -202,7 +246,7 @@ struct ToStringNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const IDMap& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"]       = PinTypeToString(m_Value.GetValueType());
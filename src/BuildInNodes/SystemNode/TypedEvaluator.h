@@ -0,0 +1,97 @@
+#pragma once
+#include <imgui.h>
+#include <SystemNode/ElementWiseKernel.h>
+
+namespace BluePrint
+{
+// Type-specialized evaluators for the arithmetic and comparison nodes. A node selects one
+// when SetType runs and then calls it through a plain function pointer, so evaluation does
+// not switch over the node type again. Values arriving through an Any link may still hold
+// another type, an evaluator returns an empty value (or -2 for compare) in that case.
+namespace Typed
+{
+using BinaryEvaluator  = PinValue (*)(const PinValue& a, const PinValue& b);
+using CompareEvaluator = int (*)(const PinValue& a, const PinValue& b);
+
+inline PinValue UnsupportedBinary(const PinValue&, const PinValue&) { return {}; }
+inline int UnsupportedCompare(const PinValue&, const PinValue&) { return -2; }
+
+template <ElementWise::Op op, typename T>
+inline PinValue Arithmetic(const PinValue& a, const PinValue& b)
+{
+    auto x = a.TryAs<T>();
+    auto y = b.TryAs<T>();
+    if (!x || !y)
+        return {}; // Error: Node values must be of same type
+    if constexpr (std::is_same<T, bool>::value)
+        return op == ElementWise::Op::Add ? bool(*x | *y) : bool(*x & *y);    // Addition as OR, Multiplication as AND
+    else if constexpr (std::is_same<T, std::string>::value)
+        return *x + *y;
+    else
+        return ElementWise::Apply<op>(*x, *y);
+}
+
+template <ElementWise::Op op, PinType type>
+inline PinValue Container(const PinValue& a, const PinValue& b)
+{
+    return ElementWise::Calculate(op, a, b, type);
+}
+
+template <ElementWise::Op op>
+inline BinaryEvaluator SelectArithmetic(PinType type)
+{
+    using ElementWise::Op;
+    switch (type)
+    {
+        case PinType::Int32:        return &Arithmetic<op, int32_t>;
+        case PinType::Int64:        return &Arithmetic<op, int64_t>;
+        case PinType::Float:        return &Arithmetic<op, float>;
+        case PinType::Double:       return &Arithmetic<op, double>;
+        case PinType::Bool:
+            if constexpr (op == Op::Add || op == Op::Mul) return &Arithmetic<op, bool>;
+            break;
+        case PinType::String:
+            if constexpr (op == Op::Add) return &Arithmetic<op, std::string>;
+            break;
+        case PinType::Mat:          return &Container<op, PinType::Mat>;
+        case PinType::FloatArray:   return &Container<op, PinType::FloatArray>;
+        case PinType::Int32Array:   return &Container<op, PinType::Int32Array>;
+        case PinType::Vec4Array:    return &Container<op, PinType::Vec4Array>;
+        default:                    break;
+    }
+    return &UnsupportedBinary;
+}
+
+// Returns 1, 0 or -1, or -2 when the values cannot be compared
+template <typename T>
+inline int Compare(const PinValue& a, const PinValue& b)
+{
+    auto x = a.TryAs<T>();
+    auto y = b.TryAs<T>();
+    if (!x || !y)
+        return -2;
+    if constexpr (std::is_same<T, std::string>::value)
+    {
+        auto r = x->compare(*y);
+        return (r > 0) - (r < 0);
+    }
+    else
+        return (*x > *y) - (*x < *y);
+}
+
+inline CompareEvaluator SelectCompare(PinType type)
+{
+    switch (type)
+    {
+        case PinType::Bool:     return &Compare<bool>;
+        case PinType::Int32:    return &Compare<int32_t>;
+        case PinType::Int64:    return &Compare<int64_t>;
+        case PinType::Float:    return &Compare<float>;
+        case PinType::Double:   return &Compare<double>;
+        case PinType::String:   return &Compare<std::string>;
+        default:                break;
+    }
+    return &UnsupportedCompare;
+}
+} // namespace Typed
+} // namespace BluePrint
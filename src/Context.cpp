@@ -25,6 +25,8 @@ const ContextMonitor* Context::GetContextMonitor() const
 void Context::ResetState()
 {
     m_Values.clear();
+    if (++m_ResetEpoch == 0)    // 0 is the epoch of nodes never reset
+        m_ResetEpoch = 1;
 }
 
 StepResult Context::Start(FlowPin& entryPoint, bool bypass_bg_node)
@@ -86,21 +88,45 @@ StepResult Context::Step(Context * context, bool restep)
     if (!entryPin->m_Node)
         return context->SetStepResult(StepResult::Done);
 
-    entryPin->m_Node->m_Hits ++;
+    // before a cache restores outputs, a late Reset would clear them again
+    entryPin->m_Node->EnsureReset(*context);
 
-    auto start_time = ImGui::get_current_time_usec();
-    auto next = entryPin->m_Node->Execute(*context, *entryPin, isthreading);
-    auto end_time = ImGui::get_current_time_usec();
-    entryPin->m_Node->m_Tick += end_time - start_time;
-
-    entryPin->m_Node->m_HitCount ++;
-    entryPin->m_Node->m_CountTimeMs += entryPin->m_Node->m_NodeTimeMs;
-    if (entryPin->m_Node->m_HitCount > 100)
+    FlowPin next = {};
+    auto blueprint = entryPin->m_Node->m_Blueprint;
+    if (blueprint && blueprint->IsIncremental() && blueprint->ReuseNodeResult(*entryPin->m_Node, next))
     {
-        entryPin->m_Node->m_HitCount = 100;
-        entryPin->m_Node->m_CountTimeMs -= entryPin->m_Node->m_AvgTimeMs;
+        // nothing it reads changed since the previous run, its outputs are still in place
+    }
+    else
+    {
+        // a node seeing inputs it already produced outputs for restores them from the output cache
+        OutputCacheProbe probe;
+        bool cached = blueprint && blueprint->IsOutputCache() &&
+                      blueprint->LookupCachedOutputs(*context, *entryPin->m_Node, next, probe, isthreading);
+        if (!cached)
+        {
+            entryPin->m_Node->m_Hits ++;
+            entryPin->m_Node->EnsurePreLoad();
+
+            auto start_time = ImGui::get_current_time_usec();
+            next = entryPin->m_Node->Execute(*context, *entryPin, isthreading);
+            auto end_time = ImGui::get_current_time_usec();
+            entryPin->m_Node->m_Tick += end_time - start_time;
+
+            entryPin->m_Node->m_HitCount ++;
+            entryPin->m_Node->m_CountTimeMs += entryPin->m_Node->m_NodeTimeMs;
+            if (entryPin->m_Node->m_HitCount > 100)
+            {
+                entryPin->m_Node->m_HitCount = 100;
+                entryPin->m_Node->m_CountTimeMs -= entryPin->m_Node->m_AvgTimeMs;
+            }
+            entryPin->m_Node->m_AvgTimeMs = entryPin->m_Node->m_HitCount > 0 ? entryPin->m_Node->m_CountTimeMs / entryPin->m_Node->m_HitCount : 0;
+            if (probe.m_Key)
+                blueprint->StoreCachedOutputs(*context, *entryPin->m_Node, std::move(probe), next);
+        }
+        if (blueprint && blueprint->IsIncremental())
+            blueprint->RecordNodeResult(*entryPin->m_Node, next);
     }
-    entryPin->m_Node->m_AvgTimeMs = entryPin->m_Node->m_HitCount > 0 ? entryPin->m_Node->m_CountTimeMs / entryPin->m_Node->m_HitCount : 0;
 
     if (next.m_Node)
     {
@@ -518,17 +544,42 @@ PinValue Context::GetPinValue(const Pin& pin, bool threading) const
 
     PinValue value;
     auto bp = pin.m_Node->m_Blueprint;
+    if (bp && pin.IsOutput() && bp->IsConstantFolding() && bp->GetFoldedValue(*this, pin, value, threading))
+        return value;
+    if (bp && pin.IsOutput() && bp->IsExprCompile() && bp->GetCompiledValue(*this, pin, value, threading))
+        return value;
+
     auto link = pin.GetLink(bp);
     if (link)
         value = GetPinValue(*link);
     else if (pin.m_Node)
+    {
+        // data nodes never executed in this run are reset on their first evaluation
+        pin.m_Node->EnsureReset(const_cast<Context&>(*this));
+        pin.m_Node->EnsurePreLoad();
         value = pin.m_Node->EvaluatePin(*this, pin, threading);
+    }
     else
         value = pin.GetValue();
 
     return std::move(value);
 }
 
+const PinValue* Context::GetPinValueRef(const Pin& pin) const
+{
+    const Pin* current = &pin;
+    while (current)
+    {
+        auto valueIt = m_Values.find(current->m_ID);
+        if (valueIt != m_Values.end())
+            return &valueIt->second;
+        if (!current->m_Node)
+            break;
+        current = current->GetLink(current->m_Node->m_Blueprint);
+    }
+    return nullptr;
+}
+
 StepResult Context::SetStepResult(StepResult result)
 {
     m_LastResult = result;
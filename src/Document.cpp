@@ -1,6 +1,9 @@
 #include <Document.h>
 #include <Utils.h>
 #include <Debug.h>
+#include <fstream>
+#include <condition_variable>
+#include <stdio.h>
 
 namespace BluePrint
 {
@@ -36,12 +39,23 @@ static string SaveReasonFlagsToString(ed::SaveReasonFlags flags, std::string sep
         return string(builder.c_str(), builder.size() - separator.size());
 }
 
+static const imgui_json::value& GetStateValue(const Document::StateValue& value)
+{
+    static const imgui_json::value null;
+    return value ? *value : null;
+}
+
+static Document::StateValue MakeStateValue(imgui_json::value&& value)
+{
+    return make_shared<const imgui_json::value>(std::move(value));
+}
+
 imgui_json::value Document::DocumentState::Serialize() const
 {
     imgui_json::value result;
-    result["nodes"] = m_NodesState;
-    result["selection"] = m_SelectionState;
-    result["blueprint"] = m_BlueprintState;
+    result["nodes"] = GetStateValue(m_NodesState);
+    result["selection"] = GetStateValue(m_SelectionState);
+    result["blueprint"] = GetStateValue(m_BlueprintState);
     return result;
 }
 
@@ -62,9 +76,9 @@ int Document::DocumentState::Deserialize(const imgui_json::value& value, Documen
     if (!nodesValue.is_object())
         return BP_ERR_DOC_LOAD;
 
-    state.m_NodesState     = nodesValue;
-    state.m_SelectionState = selectionValue;
-    state.m_BlueprintState = dataValue;
+    state.m_NodesState     = MakeStateValue(imgui_json::value(nodesValue));
+    state.m_SelectionState = MakeStateValue(imgui_json::value(selectionValue));
+    state.m_BlueprintState = MakeStateValue(imgui_json::value(dataValue));
 
     result = std::move(state);
 
@@ -227,7 +241,7 @@ bool Document::OnSaveState(const imgui_json::value& value, ed::SaveReasonFlags r
 {
     if ((reason & ed::SaveReasonFlags::Selection) == ed::SaveReasonFlags::Selection)
     {
-        m_DocumentState.m_SelectionState = ed::GetState(ed::StateType::Selection);
+        m_DocumentState.m_SelectionState = MakeStateValue(ed::GetState(ed::StateType::Selection));
         m_SaveTransaction->AddAction("Selection Changed");
     }
 
@@ -279,14 +293,19 @@ void Document::SetPath(std::string path)
         m_Name = path;
 }
 
-imgui_json::value Document::Serialize() const
+static imgui_json::value SerializeDocument(const Document::DocumentState& document, const Document::NavigationState& navigation)
 {
     imgui_json::value result;
-    result["document"] = m_DocumentState.Serialize();
-    result["view"] = m_NavigationState.m_ViewState;
+    result["document"] = document.Serialize();
+    result["view"] = navigation.m_ViewState;
     return result;
 }
 
+imgui_json::value Document::Serialize() const
+{
+    return SerializeDocument(m_DocumentState, m_NavigationState);
+}
+
 int Document::Deserialize(const imgui_json::value& value, Document& result)
 {
     if (!value.is_object())
@@ -303,7 +322,7 @@ int Document::Deserialize(const imgui_json::value& value, Document& result)
 
     result.m_NavigationState.m_ViewState = viewValue;
 
-    if (result.m_Blueprint.Load(result.m_DocumentState.m_BlueprintState) != 0)
+    if (result.m_Blueprint.Load(*result.m_DocumentState.m_BlueprintState) != 0)
         return BP_ERR_DOC_LOAD;
 
     return BP_ERR_NONE;
@@ -332,10 +351,117 @@ int Document::Import(std::string path, ImVec2 pos)
     return m_Blueprint.Import(loadResult.first, pos);
 }
 
+// Write to a temporary file next to target and rename over it, a crash during
+// the write never leaves a truncated document behind
+static bool WriteDocumentFile(const imgui_json::value& value, const std::string& path)
+{
+    auto temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        auto data = value.dump(4);
+        file.write(data.data(), data.size());
+        if (!file.good())
+        {
+            file.close();
+            remove(temp_path.c_str());
+            return false;
+        }
+    }
+#if defined(_WIN32)
+    remove(path.c_str());
+#endif
+    if (rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// -------[ SaveWorker ]-------
+// Pending snapshots are kept per path, a newer one replaces an older one not yet
+// written so bursts of saves coalesce into a single write. Snapshots share their
+// state with the document, the json is built here, off the UI thread.
+struct Document::SaveWorker
+{
+    struct Snapshot
+    {
+        DocumentState   m_Document;
+        NavigationState m_Navigation;
+    };
+
+    ~SaveWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Condition.notify_all();
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    void Post(Snapshot&& snapshot, std::string path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Pending[path] = std::move(snapshot);
+            if (!m_Thread.joinable())
+                m_Thread = std::thread(&SaveWorker::Run, this);
+        }
+        m_Condition.notify_all();
+    }
+
+    bool Flush()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this] { return m_Pending.empty() && !m_Busy; });
+        return m_Result;
+    }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            m_Condition.wait(lock, [this] { return m_Quit || !m_Pending.empty(); });
+            if (m_Pending.empty())
+                break; // quit only after all pending snapshots are written
+            auto it = m_Pending.begin();
+            auto path = it->first;
+            auto snapshot = std::move(it->second);
+            m_Pending.erase(it);
+            m_Busy = true;
+            lock.unlock();
+            bool result = WriteDocumentFile(SerializeDocument(snapshot.m_Document, snapshot.m_Navigation), path);
+            if (!result)
+            {
+                LOGE("[Document] Background save to \"%s\" failed", path.c_str());
+            }
+            lock.lock();
+            m_Result = result;
+            m_Busy = false;
+            m_Condition.notify_all();
+        }
+    }
+
+    std::mutex                                  m_Mutex;
+    std::condition_variable                     m_Condition;
+    std::thread                                 m_Thread;
+    std::map<std::string, Snapshot>             m_Pending;
+    bool                                        m_Busy {false};
+    bool                                        m_Quit {false};
+    bool                                        m_Result {true};
+};
+
 bool Document::Save(std::string path) const
 {
+    // keep an older background snapshot from landing after this write
+    FlushSave();
     auto result = Serialize();
-    return result.save(path);
+    return WriteDocumentFile(result, path);
 }
 
 bool Document::Save() const
@@ -345,6 +471,49 @@ bool Document::Save() const
     return Save(m_Path);
 }
 
+bool Document::SaveAsync(std::string path)
+{
+    if (path.empty())
+        path = m_Path;
+    if (path.empty())
+        return false;
+    if (!m_SaveWorker)
+        m_SaveWorker = make_shared<SaveWorker>();
+    m_SaveWorker->Post({ m_DocumentState, m_NavigationState }, path);
+    return true;
+}
+
+bool Document::FlushSave() const
+{
+    if (!m_SaveWorker)
+        return true;
+    return m_SaveWorker->Flush();
+}
+
+void Document::SetAutoSave(bool enable, float interval)
+{
+    m_AutoSave = enable;
+    m_AutoSaveInterval = interval > 0.f ? interval : 1.f;
+    m_AutoSaveTime = ImGui::get_current_time_usec();
+}
+
+void Document::UpdateAutoSave()
+{
+    if (!m_AutoSave || !m_IsModified || m_Path.empty())
+        return;
+    auto now = ImGui::get_current_time_usec();
+    if (now - m_AutoSaveTime < (int64_t)(m_AutoSaveInterval * 1000000.f))
+        return;
+    m_AutoSaveTime = now;
+    auto& state = m_DocumentState;
+    if (state.m_BlueprintState == m_AutoSaveState.m_BlueprintState &&
+        state.m_NodesState == m_AutoSaveState.m_NodesState &&
+        state.m_SelectionState == m_AutoSaveState.m_SelectionState)
+        return;
+    if (SaveAsync(m_Path + ".autosave"))
+        m_AutoSaveState = state;
+}
+
 bool Document::Undo()
 {
     if (m_Undo.empty())
@@ -390,9 +559,11 @@ bool Document::Redo()
 Document::DocumentState Document::BuildDocumentState()
 {
     DocumentState result;
-    m_Blueprint.Save(result.m_BlueprintState);
-    result.m_SelectionState = ed::GetState(ed::StateType::Selection);
-    result.m_NodesState = ed::GetState(ed::StateType::Nodes);
+    imgui_json::value blueprintState;
+    m_Blueprint.Save(blueprintState);
+    result.m_BlueprintState = MakeStateValue(std::move(blueprintState));
+    result.m_SelectionState = MakeStateValue(ed::GetState(ed::StateType::Selection));
+    result.m_NodesState = MakeStateValue(ed::GetState(ed::StateType::Nodes));
     return result;
 }
 
@@ -408,8 +579,8 @@ void Document::ApplyState(const DocumentState& state)
     // TODO::Dicky do we need load bp again since we already load on document
 
     m_DocumentState = state;
-    ed::ApplyState(ed::StateType::Nodes, m_DocumentState.m_NodesState);
-    ed::ApplyState(ed::StateType::Selection, m_DocumentState.m_SelectionState);
+    ed::ApplyState(ed::StateType::Nodes, GetStateValue(m_DocumentState.m_NodesState));
+    ed::ApplyState(ed::StateType::Selection, GetStateValue(m_DocumentState.m_SelectionState));
 }
 
 void Document::OnMakeCurrent()
@@ -0,0 +1,277 @@
+#include <Expression.h>
+#include <Node.h>
+#include <SystemNode/ElementWiseKernel.h>
+
+namespace BluePrint
+{
+# pragma region Expression
+bool ExprTypeFromPinType(PinType pinType, ExprType& type)
+{
+    switch (pinType)
+    {
+        case PinType::Bool:     type = ExprType::Bool;   return true;
+        case PinType::Int32:    type = ExprType::Int32;  return true;
+        case PinType::Int64:    type = ExprType::Int64;  return true;
+        case PinType::Float:    type = ExprType::Float;  return true;
+        case PinType::Double:   type = ExprType::Double; return true;
+        default:                return false;
+    }
+}
+
+static bool LoadRegister(const PinValue& value, ExprType type, ExprRegister& reg)
+{
+    switch (type)
+    {
+        case ExprType::Bool:   if (auto v = value.TryAs<bool>())    { reg.b   = *v; return true; } break;
+        case ExprType::Int32:  if (auto v = value.TryAs<int32_t>()) { reg.i32 = *v; return true; } break;
+        case ExprType::Int64:  if (auto v = value.TryAs<int64_t>()) { reg.i64 = *v; return true; } break;
+        case ExprType::Float:  if (auto v = value.TryAs<float>())   { reg.f32 = *v; return true; } break;
+        case ExprType::Double: if (auto v = value.TryAs<double>())  { reg.f64 = *v; return true; } break;
+        default: break;
+    }
+    return false;
+}
+
+static PinValue StoreRegister(const ExprRegister& reg, ExprType type)
+{
+    switch (type)
+    {
+        case ExprType::Bool:   return reg.b;
+        case ExprType::Int32:  return reg.i32;
+        case ExprType::Int64:  return reg.i64;
+        case ExprType::Float:  return reg.f32;
+        case ExprType::Double: return reg.f64;
+        default:               return {};
+    }
+}
+
+template <typename T>
+static inline int32_t CompareRegister(T a, T b)
+{
+    return (a > b) - (a < b);
+}
+
+# define EXPR_ARITHMETIC(OP, TYPE, FIELD) \
+    case ExprCode(ExprOp::OP, ExprType::TYPE): \
+        r[ins.m_Dst].FIELD = ElementWise::Apply<ElementWise::Op::OP>(r[ins.m_A].FIELD, r[ins.m_B].FIELD); break;
+
+# define EXPR_NUMERIC(TYPE, FIELD) \
+    case ExprCode(ExprOp::Load, ExprType::TYPE): \
+        if (!LoadRegister(context.GetPinValue(*m_Inputs[ins.m_A], threading), ExprType::TYPE, r[ins.m_Dst])) { return false; } break; \
+    case ExprCode(ExprOp::Move, ExprType::TYPE): r[ins.m_Dst].FIELD = r[ins.m_A].FIELD; break; \
+    EXPR_ARITHMETIC(Add, TYPE, FIELD) \
+    EXPR_ARITHMETIC(Sub, TYPE, FIELD) \
+    EXPR_ARITHMETIC(Mul, TYPE, FIELD) \
+    EXPR_ARITHMETIC(Div, TYPE, FIELD) \
+    case ExprCode(ExprOp::Compare, ExprType::TYPE): r[ins.m_Dst].i32 = CompareRegister(r[ins.m_A].FIELD, r[ins.m_B].FIELD); break;
+
+bool ExprProgram::Run(const Context& context, PinValue& value, bool threading) const
+{
+    // Load may evaluate nodes outside the region which run programs of their own, so registers
+    // live on this frame rather than in a shared buffer
+    ExprRegister local[64];
+    std::vector<ExprRegister> heap;
+    ExprRegister* r = local;
+    if (m_Registers > 64)
+    {
+        heap.resize(m_Registers);
+        r = heap.data();
+    }
+
+    const ExprInstr* code = m_Code.data();
+    const size_t size = m_Code.size();
+    for (size_t pc = 0; pc < size; pc++)
+    {
+        const ExprInstr& ins = code[pc];
+        switch (ins.m_Code)
+        {
+            EXPR_NUMERIC(Int32, i32)
+            EXPR_NUMERIC(Int64, i64)
+            EXPR_NUMERIC(Float, f32)
+            EXPR_NUMERIC(Double, f64)
+
+            case ExprCode(ExprOp::Load, ExprType::Bool):
+                if (!LoadRegister(context.GetPinValue(*m_Inputs[ins.m_A], threading), ExprType::Bool, r[ins.m_Dst])) { return false; } break;
+            case ExprCode(ExprOp::Move, ExprType::Bool):    r[ins.m_Dst].b = r[ins.m_A].b; break;
+            case ExprCode(ExprOp::Add, ExprType::Bool):     r[ins.m_Dst].b = r[ins.m_A].b | r[ins.m_B].b; break;
+            case ExprCode(ExprOp::Mul, ExprType::Bool):     r[ins.m_Dst].b = r[ins.m_A].b & r[ins.m_B].b; break;
+            case ExprCode(ExprOp::Compare, ExprType::Bool): r[ins.m_Dst].i32 = CompareRegister(r[ins.m_A].b, r[ins.m_B].b); break;
+
+            case ExprCode(ExprOp::Jump, ExprType::Bool):      pc = size_t(ins.m_A) - 1; break;
+            case ExprCode(ExprOp::JumpIfNot, ExprType::Bool): if (!r[ins.m_B].b) pc = size_t(ins.m_A) - 1; break;
+
+            default:
+                if (ins.m_Function)
+                    ins.m_Function(r[ins.m_Dst], r[ins.m_A], r[ins.m_B], r[ins.m_C]);
+                break;
+        }
+    }
+
+    value = StoreRegister(r[m_Result], m_ResultType);
+    return true;
+}
+
+# undef EXPR_NUMERIC
+# undef EXPR_ARITHMETIC
+
+bool ExprCompiler::Compile(const Pin& output, ExprProgram& program)
+{
+    program = ExprProgram();
+    m_Program = &program;
+    m_Types.clear();
+    m_Memo.clear();
+    m_Lowering.clear();
+
+    auto result = Lower(output);
+    m_Program = nullptr;
+    if (result < 0)
+        return false;
+    program.m_Registers  = uint16_t(m_Types.size());
+    program.m_Result     = uint16_t(result);
+    program.m_ResultType = m_Types[result];
+    return true;
+}
+
+int ExprCompiler::Input(const Pin& input, ExprType type)
+{
+    auto provider = input.GetLink(m_Blueprint);
+    if (!provider || provider->IsMappedPin())
+        return Load(input, type);
+    return Output(*provider, type);
+}
+
+int ExprCompiler::Emit(ExprOp op, ExprType type, int a, int b)
+{
+    if (a < 0 || m_Types[a] != type)
+        return -1;
+    if (op == ExprOp::Move)
+        return Push(op, type, Alloc(type), a);
+    if (b < 0 || m_Types[b] != type)
+        return -1;
+    if (type == ExprType::Bool && (op == ExprOp::Sub || op == ExprOp::Div))
+        return -1;
+    switch (op)
+    {
+        case ExprOp::Add:
+        case ExprOp::Sub:
+        case ExprOp::Mul:
+        case ExprOp::Div:       return Push(op, type, Alloc(type), a, b);
+        case ExprOp::Compare:   return Push(op, type, Alloc(ExprType::Int32), a, b);
+        default:                return -1;
+    }
+}
+
+int ExprCompiler::Call(ExprFunction function, ExprType type, int a, int b, int c)
+{
+    if (!function)
+        return -1;
+    auto dst = Alloc(type);
+    if (dst < 0)
+        return -1;
+    // the opcode itself is never dispatched on, Run calls m_Function for it
+    return Push(ExprOp::Call, type, dst, a < 0 ? dst : a, b < 0 ? dst : b, c < 0 ? dst : c, function);
+}
+
+int ExprCompiler::Select(int condition, const Pin& a, const Pin& b, ExprType type)
+{
+    if (condition < 0 || m_Types[condition] != ExprType::Bool)
+        return -1;
+    auto dst = Alloc(type);
+    if (dst < 0)
+        return -1;
+
+    // values computed inside one branch must not be reused after it, keep the memo per branch
+    auto memo = m_Memo;
+    auto jumpToB = m_Program->m_Code.size();
+    Push(ExprOp::JumpIfNot, ExprType::Bool, 0, 0, condition);
+    auto valueA = Push(ExprOp::Move, type, dst, Input(a, type));
+    auto jumpToEnd = m_Program->m_Code.size();
+    Push(ExprOp::Jump, ExprType::Bool, 0, 0);
+    m_Memo = memo;
+
+    m_Program->m_Code[jumpToB].m_A = uint16_t(m_Program->m_Code.size());
+    auto valueB = Push(ExprOp::Move, type, dst, Input(b, type));
+    m_Memo = std::move(memo);
+
+    m_Program->m_Code[jumpToEnd].m_A = uint16_t(m_Program->m_Code.size());
+    if (valueA < 0 || valueB < 0 || m_Program->m_Code.size() > 0xFFFF)
+        return -1;
+    return dst;
+}
+
+int ExprCompiler::Lower(const Pin& output)
+{
+    auto node = output.m_Node;
+    if (!node || !(node->GetCaps() & NODE_CAPS_EXPR))
+        return -1;
+    if (std::find(m_Lowering.begin(), m_Lowering.end(), node) != m_Lowering.end())
+        return -1;
+
+    m_Lowering.push_back(node);
+    auto result = node->CompileExpr(*this, output);
+    m_Lowering.pop_back();
+    return result;
+}
+
+int ExprCompiler::Output(const Pin& output, ExprType type)
+{
+    auto memoIt = m_Memo.find(&output);
+    if (memoIt != m_Memo.end())
+        return m_Types[memoIt->second] == type ? memoIt->second : -1;
+
+    // a node that cannot lower this output leaves no trace, its value is loaded instead
+    auto code = m_Program->m_Code.size();
+    auto inputs = m_Program->m_Inputs.size();
+    auto registers = m_Types.size();
+    auto result = Lower(output);
+    if (result < 0 || m_Types[result] != type)
+    {
+        m_Program->m_Code.resize(code);
+        m_Program->m_Inputs.resize(inputs);
+        m_Types.resize(registers);
+        for (auto it = m_Memo.begin(); it != m_Memo.end();)
+        {
+            if (it->second >= int(registers))
+                it = m_Memo.erase(it);
+            else
+                ++it;
+        }
+        result = Load(output, type);
+    }
+    if (result >= 0)
+        m_Memo[&output] = result;
+    return result;
+}
+
+int ExprCompiler::Load(const Pin& pin, ExprType type)
+{
+    if (m_Program->m_Inputs.size() > 0xFFFF)
+        return -1;
+    m_Program->m_Inputs.push_back(&pin);
+    return Push(ExprOp::Load, type, Alloc(type), int(m_Program->m_Inputs.size() - 1));
+}
+
+int ExprCompiler::Alloc(ExprType type)
+{
+    if (m_Types.size() >= 0xFFFF)
+        return -1;
+    m_Types.push_back(type);
+    return int(m_Types.size() - 1);
+}
+
+int ExprCompiler::Push(ExprOp op, ExprType type, int dst, int a, int b, int c, ExprFunction function)
+{
+    if (dst < 0 || a < 0 || b < 0 || c < 0)
+        return -1;
+    ExprInstr ins;
+    ins.m_Code      = ExprCode(op, type);
+    ins.m_Dst       = uint16_t(dst);
+    ins.m_A         = uint16_t(a);
+    ins.m_B         = uint16_t(b);
+    ins.m_C         = uint16_t(c);
+    ins.m_Function  = function;
+    m_Program->m_Code.push_back(ins);
+    return dst;
+}
+# pragma endregion
+} // namespace BluePrint
@@ -3,6 +3,8 @@
 #include <imgui_node_editor_internal.h>
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
+#include <unordered_set>
+#include <sys/stat.h>
 
 namespace BluePrint
 {
@@ -155,7 +157,10 @@ ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
     });
 
     if (it != m_CustomNodes.end())
+    {
+        ForgetType(&*it);
         m_CustomNodes.erase(it);
+    }
 
     NodeTypeInfo typeInfo;
     typeInfo.m_ID               = id;
@@ -169,29 +174,45 @@ ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
     typeInfo.m_Style            = info->m_Style;
     typeInfo.m_Catalog          = info->m_Catalog;
     typeInfo.m_Factory          = info->m_Factory;
+    typeInfo.m_Caps             = info->m_Caps;
     typeInfo.m_Url              = info->m_Url;
 
     m_CustomNodes.push_back(std::move(typeInfo));
 
-    RebuildTypes();
+    RequestRebuildTypes();
 
     return id;
 }
 
 ID_TYPE NodeRegistry::RegisterNodeType(std::string Path)
 {
+    auto module = OpenNodeModule(Path);
+    return RegisterNodeModule(module);
+}
+
+NodeRegistry::NodeModule NodeRegistry::OpenNodeModule(std::string Path)
+{
+    NodeModule module;
+    module.m_Path = Path;
     auto dlobject = new DLClass<NodeTypeInfo>(Path.c_str());
     if (!dlobject)
     {
-        return 0;
+        return module;
     }
     auto info = dlobject->make_obj();
     if (!info)
     {
         delete dlobject;
-        return 0;
+        return module;
     }
+    module.m_Object = dlobject;
+    module.m_Info = info;
+    return module;
+}
 
+// Plugins built against an older SDK still load, with a warning
+static void CheckModuleVersions(DLClass<NodeTypeInfo>* dlobject)
+{
     int32_t version = dlobject->get_version();
     if (version < VERSION_BLUEPRINT)
     {
@@ -206,10 +227,176 @@ ID_TYPE NodeRegistry::RegisterNodeType(std::string Path)
                 VERSION_MAJOR(api_version), VERSION_MINOR(api_version), VERSION_PATCH(api_version),
                 VERSION_MAJOR(VERSION_BLUEPRINT_API), VERSION_MINOR(VERSION_BLUEPRINT_API), VERSION_PATCH(VERSION_BLUEPRINT_API));
     }
+}
 
-    m_ExternalObject.push_back(dlobject);
+ID_TYPE NodeRegistry::RegisterNodeModule(NodeModule& module)
+{
+    auto dlobject = module.m_Object;
+    auto info = module.m_Info;
+    if (!dlobject || !info)
+        return 0;
+    module.m_Object = nullptr; // registry owns it now
+
+    CheckModuleVersions(dlobject);
+    {
+        std::lock_guard<std::mutex> lock(m_DeferredMutex);
+        m_ExternalObject.push_back(dlobject);
+    }
     info->m_Url = dlobject->get_module_path();//ImGuiHelper::path_url(Path);
-    return RegisterNodeType(info);
+    auto id = RegisterNodeType(info);
+    if (id) m_PluginPaths[module.m_Path] = id;
+    return id;
+}
+
+static int64_t PluginModifyTime(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return -1;
+    return (int64_t)st.st_mtime;
+}
+
+bool NodeRegistry::LoadManifest(std::string path)
+{
+    auto manifest = imgui_json::value::load(path);
+    if (!manifest.second)
+        return false;
+    VERSION_TYPE sdk_version = 0;
+    if (!imgui_json::GetTo<imgui_json::number>(manifest.first, "sdk_version", sdk_version) || sdk_version != VERSION_BLUEPRINT)
+        return false;
+    const imgui_json::array* pluginArray = nullptr;
+    if (!imgui_json::GetPtrTo(manifest.first, "plugins", pluginArray))
+        return false;
+
+    BeginRegistration();
+    for (auto& pluginValue : *pluginArray)
+    {
+        string plugin_path;
+        int64_t mtime = 0;
+        if (!imgui_json::GetTo<imgui_json::string>(pluginValue, "path", plugin_path) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "mtime", mtime))
+            continue;
+        // plugin changed or removed since manifest was written, let caller load it for real
+        if (PluginModifyTime(plugin_path) != mtime)
+            continue;
+        auto info = make_shared<NodeTypeInfo>();
+        string type, style;
+        if (!imgui_json::GetTo<imgui_json::number>(pluginValue, "id", info->m_ID) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "url", info->m_Url))
+            continue;
+        imgui_json::GetTo<imgui_json::string>(pluginValue, "name", info->m_Name);
+        imgui_json::GetTo<imgui_json::string>(pluginValue, "type_name", info->m_NodeTypeName);
+        imgui_json::GetTo<imgui_json::string>(pluginValue, "author", info->m_Author);
+        imgui_json::GetTo<imgui_json::string>(pluginValue, "catalog", info->m_Catalog);
+        imgui_json::GetTo<imgui_json::number>(pluginValue, "version", info->m_Version);
+        imgui_json::GetTo<imgui_json::number>(pluginValue, "node_sdk_version", info->m_SDK_Version);
+        imgui_json::GetTo<imgui_json::number>(pluginValue, "api_version", info->m_API_Version);
+        if (imgui_json::GetTo<imgui_json::string>(pluginValue, "type", type)) NodeTypeFromString(type, info->m_Type);
+        if (imgui_json::GetTo<imgui_json::string>(pluginValue, "style", style)) NodeStyleFromString(style, info->m_Style);
+        imgui_json::GetTo<imgui_json::number>(pluginValue, "caps", info->m_Caps);
+        info->m_Factory = nullptr; // resolved by ResolveDeferredType
+        if (RegisterNodeType(info))
+            m_PluginPaths[plugin_path] = info->m_ID;
+    }
+    EndRegistration();
+    return true;
+}
+
+bool NodeRegistry::SaveManifest(std::string path) const
+{
+    imgui_json::value manifest;
+    manifest["sdk_version"] = imgui_json::number(VERSION_BLUEPRINT);
+    auto& pluginsValue = manifest["plugins"];
+    pluginsValue = imgui_json::array();
+    for (auto& plugin : m_PluginPaths)
+    {
+        auto info = GetTypeInfo(plugin.second);
+        if (!info)
+            continue;
+        imgui_json::value pluginValue;
+        pluginValue["path"] = plugin.first;
+        pluginValue["mtime"] = imgui_json::number(PluginModifyTime(plugin.first));
+        pluginValue["id"] = imgui_json::number(info->m_ID);
+        pluginValue["url"] = info->m_Url;
+        pluginValue["name"] = info->m_Name;
+        pluginValue["type_name"] = info->m_NodeTypeName;
+        pluginValue["author"] = info->m_Author;
+        pluginValue["catalog"] = info->m_Catalog;
+        pluginValue["version"] = imgui_json::number(info->m_Version);
+        pluginValue["node_sdk_version"] = imgui_json::number(info->m_SDK_Version);
+        pluginValue["api_version"] = imgui_json::number(info->m_API_Version);
+        pluginValue["type"] = NodeTypeToString(info->m_Type);
+        pluginValue["style"] = NodeStyleToString(info->m_Style);
+        pluginValue["caps"] = imgui_json::number(info->m_Caps);
+        pluginsValue.push_back(std::move(pluginValue));
+    }
+    return manifest.save(path);
+}
+
+bool NodeRegistry::HasPlugin(std::string path) const
+{
+    return m_PluginPaths.find(path) != m_PluginPaths.end();
+}
+
+NodeTypeInfo::Factory NodeRegistry::ResolveDeferredType(NodeTypeInfo& typeInfo)
+{
+    // type came from manifest, open the plugin now. Entry is patched in place so
+    // pointers handed out by GetTypes()/GetTypeInfo() stay valid. Load and prefetch
+    // threads create nodes too, the lock keeps the plugin from being opened twice.
+    std::lock_guard<std::mutex> lock(m_DeferredMutex);
+    if (typeInfo.m_Factory)
+        return typeInfo.m_Factory;
+    if (typeInfo.m_Url.empty())
+        return nullptr;
+    auto dlobject = new DLClass<NodeTypeInfo>(typeInfo.m_Url.c_str());
+    if (!dlobject)
+        return nullptr;
+    auto info = dlobject->make_obj();
+    if (!info || info->m_ID != typeInfo.m_ID || !info->m_Factory)
+    {
+        LOGE("[RegisterNodeType] Deferred plugin %s does not provide type %08X\n", typeInfo.m_Url.c_str(), typeInfo.m_ID);
+        delete dlobject;
+        return nullptr;
+    }
+    // the manifest may be older than the plugin it names, check it like RegisterNodeModule does
+    CheckModuleVersions(dlobject);
+    m_ExternalObject.push_back(dlobject);
+    typeInfo.m_Factory = info->m_Factory;
+    return typeInfo.m_Factory;
+}
+
+std::vector<ID_TYPE> NodeRegistry::RegisterNodeTypes(span<const std::string> paths)
+{
+    std::vector<ID_TYPE> ids;
+    ids.reserve(paths.size());
+    BeginRegistration();
+    for (auto& path : paths)
+        ids.push_back(RegisterNodeType(path));
+    EndRegistration();
+    return ids;
+}
+
+void NodeRegistry::BeginRegistration()
+{
+    // the current index stays readable, m_CustomNodes keeps its entries in place while
+    // registering, types added by the batch show up when EndRegistration swaps in the new index
+    m_RegistrationDepth++;
+}
+
+void NodeRegistry::EndRegistration()
+{
+    if (m_RegistrationDepth == 0)
+        return;
+    if (--m_RegistrationDepth == 0 && m_TypesDirty)
+        RebuildTypes();
+}
+
+void NodeRegistry::RequestRebuildTypes()
+{
+    if (m_RegistrationDepth > 0)
+        m_TypesDirty = true;
+    else
+        RebuildTypes();
 }
 
 void NodeRegistry::UnregisterNodeType(std::string name)
@@ -222,82 +409,91 @@ void NodeRegistry::UnregisterNodeType(std::string name)
     if (it == m_CustomNodes.end())
         return;
 
+    ForgetType(&*it);
     m_CustomNodes.erase(it);
 
-    RebuildTypes();
+    RequestRebuildTypes();
+}
+
+void NodeRegistry::ForgetType(const NodeTypeInfo* typeInfo)
+{
+    // entry is about to be erased, the index must not keep pointing at it until the next rebuild
+    m_Types.erase(std::remove(m_Types.begin(), m_Types.end(), typeInfo), m_Types.end());
+    auto id = m_TypesByID.find(typeInfo->m_ID);
+    if (id != m_TypesByID.end() && id->second == typeInfo)
+        m_TypesByID.erase(id);
+    auto name = m_TypesByName.find(typeInfo->m_Name);
+    if (name != m_TypesByName.end() && name->second == typeInfo)
+        m_TypesByName.erase(name);
+    m_TypesDirty = true;
 }
 
 void NodeRegistry::RebuildTypes()
 {
-    m_Types.resize(0);
-    m_Types.reserve(m_CustomNodes.size() + std::distance(std::begin(m_BuildInNodes), std::end(m_BuildInNodes)));
+    // build the new index aside and swap it in, readers never see it half done
+    std::vector<NodeTypeInfo*> types;
+    types.reserve(m_CustomNodes.size() + std::distance(std::begin(m_BuildInNodes), std::end(m_BuildInNodes)));
 
     for (auto& typeInfo : m_CustomNodes)
-        m_Types.push_back(&typeInfo);
+        types.push_back(&typeInfo);
 
     for (auto& typeInfo : m_BuildInNodes)
-        m_Types.push_back(&typeInfo);
+        types.push_back(&typeInfo);
+
+    std::sort(types.begin(), types.end(), [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
+    types.erase(std::unique(types.begin(), types.end()), types.end());
 
-    std::sort(m_Types.begin(), m_Types.end(), [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
-    m_Types.erase(std::unique(m_Types.begin(), m_Types.end()), m_Types.end());
+    std::unordered_map<ID_TYPE, NodeTypeInfo*> typesByID;
+    std::unordered_map<std::string, NodeTypeInfo*> typesByName;
+    typesByID.reserve(types.size());
+    typesByName.reserve(types.size());
+    for (auto type : types)
+    {
+        typesByID.emplace(type->m_ID, type);
+        typesByName.emplace(type->m_Name, type);
+    }
+    m_Types.swap(types);
+    m_TypesByID.swap(typesByID);
+    m_TypesByName.swap(typesByName);
 
     // rebuild catalog
+    std::unordered_set<std::string> catalogs(m_Catalogs.begin(), m_Catalogs.end());
     for (auto type : m_Types)
     {
-        bool alread_in_list = false;
-        for (auto catalog : m_Catalogs)
-        {
-            if (catalog.compare(type->m_Catalog) == 0)
-            {
-                alread_in_list = true;
-                break;
-            }
-        }
-        if (!alread_in_list)
+        if (catalogs.insert(type->m_Catalog).second)
         {
             m_Catalogs.push_back(type->m_Catalog);
         }
-        bool alread_in_nodes = false;
-        for (auto node : m_Nodes)
-        {
-            if (node->GetTypeID() == type->m_ID)
-            {
-                alread_in_nodes = true;
-                break;
-            }
-        }
-        if (!alread_in_nodes)
-        {
-            auto node = Create(type->m_ID, nullptr);
-            if (node) m_Nodes.push_back(node);
-        }
     }
+    m_TypesDirty = false;
+
+    // prototype nodes are built by GetNodes() when someone asks for them
+    std::lock_guard<std::mutex> lock(m_NodesMutex);
+    m_NodesDirty = true;
 }
 
 Node* NodeRegistry::Create(ID_TYPE typeId, BP* blueprint)
 {
-    for (auto& nodeInfo : m_Types)
-    {
-        if (nodeInfo->m_ID != typeId)
-            continue;
-
-        return nodeInfo->m_Factory(blueprint);
-    }
-
-    return nullptr;
+    auto it = m_TypesByID.find(typeId);
+    if (it == m_TypesByID.end())
+        return nullptr;
+
+    auto factory = ResolveDeferredType(*it->second);
+    if (!factory)
+        return nullptr;
+    return factory(blueprint);
 }
 
 Node* NodeRegistry::Create(std::string typeName, BP* blueprint)
 {
-    for (auto& nodeInfo : m_Types)
-    {
-        if (nodeInfo->m_Name != typeName)
-            continue;
-
-        return nodeInfo->m_Factory(blueprint);
-    }
-
-    return nullptr;
+    auto it = m_TypesByName.find(typeName);
+    if (it == m_TypesByName.end())
+        return nullptr;
+
+    auto factory = ResolveDeferredType(*it->second);
+    if (!factory)
+        return nullptr;
+    return factory(blueprint);
 }
 
 span<const NodeTypeInfo* const> NodeRegistry::GetTypes() const
@@ -316,6 +512,30 @@ span<const std::string> NodeRegistry::GetCatalogs() const
 
 span<const Node * const> NodeRegistry::GetNodes() const
 {
+    std::lock_guard<std::mutex> lock(m_NodesMutex);
+    if (m_NodesDirty)
+    {
+        std::unordered_set<ID_TYPE> nodes;
+        nodes.reserve(m_Nodes.size());
+        for (auto node : m_Nodes)
+            nodes.insert(node->GetTypeID());
+        for (auto type : m_Types)
+        {
+            // deferred plugin types get no prototype, it would force the plugin open
+            NodeTypeInfo::Factory factory = nullptr;
+            {
+                std::lock_guard<std::mutex> deferredLock(m_DeferredMutex);
+                factory = type->m_Factory;
+            }
+            if (factory && nodes.insert(type->m_ID).second)
+            {
+                auto node = factory(nullptr);
+                if (node) m_Nodes.push_back(node);
+            }
+        }
+        m_NodesDirty = false;
+    }
+
     const Node* const* begin = m_Nodes.data();
     const Node* const* end   = m_Nodes.data() + m_Nodes.size();
     return make_span(begin, end);
@@ -323,10 +543,22 @@ span<const Node * const> NodeRegistry::GetNodes() const
 
 const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
 {
-    for (auto& nodeInfo : m_Types)
+    auto it = m_TypesByID.find(typeId);
+    if (it != m_TypesByID.end())
+        return it->second;
+    if (m_RegistrationDepth > 0)
     {
-        if (nodeInfo->m_ID == typeId)
-            return nodeInfo;
+        // types registered by the running batch are not indexed yet
+        for (auto& nodeInfo : m_CustomNodes)
+        {
+            if (nodeInfo.m_ID == typeId)
+                return &nodeInfo;
+        }
+        for (auto& nodeInfo : m_BuildInNodes)
+        {
+            if (nodeInfo.m_ID == typeId)
+                return &nodeInfo;
+        }
     }
     return nullptr;
 }
@@ -334,6 +566,25 @@ const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
 // ----------------------
 // -------[ Node ]-------
 // ----------------------
+void Node::EnsurePreLoad()
+{
+    if (m_PreLoaded.load(std::memory_order_acquire))
+        return;
+    std::lock_guard<std::mutex> lock(m_PreLoadMutex);
+    if (m_PreLoaded.load(std::memory_order_relaxed))
+        return;
+    PreLoad();
+    m_PreLoaded.store(true, std::memory_order_release);
+}
+
+void Node::EnsureReset(Context& context)
+{
+    // claim the epoch before Reset, a Reset reading the node's own pins must not reset it again
+    auto epoch = context.m_ResetEpoch;
+    if (m_ResetEpoch.load(std::memory_order_acquire) == epoch || m_ResetEpoch.exchange(epoch) == epoch)
+        return;
+    Reset(context);
+}
 
 Node::Node(BP* blueprint)
     : m_Blueprint(blueprint)
@@ -358,6 +609,9 @@ unique_ptr<Pin> Node::CreatePin(PinType pinType, std::string name)
         case PinType::Point:    return make_unique<PointPin>(this, name);
         case PinType::Vec2:     return make_unique<Vec2Pin>(this, name);
         case PinType::Vec4:     return make_unique<Vec4Pin>(this, name);
+        case PinType::FloatArray: return make_unique<FloatArrayPin>(this, name);
+        case PinType::Int32Array: return make_unique<Int32ArrayPin>(this, name);
+        case PinType::Vec4Array:  return make_unique<Vec4ArrayPin>(this, name);
     }
 
     return nullptr;
@@ -381,6 +635,9 @@ Pin * Node::NewPin(PinType pinType, std::string name)
         case PinType::Vec4 :    pin = new Vec4Pin(this, name); break;
         case PinType::Mat :     pin = new MatPin(this, name); break;
         case PinType::Array :   pin = new ArrayPin(this, name); break;
+        case PinType::FloatArray : pin = new FloatArrayPin(this, name); break;
+        case PinType::Int32Array : pin = new Int32ArrayPin(this, name); break;
+        case PinType::Vec4Array :  pin = new Vec4ArrayPin(this, name); break;
         default: break;
     }
     return pin;
@@ -396,6 +653,18 @@ ID_TYPE Node::GetTypeID() const
     return GetTypeInfo().m_ID;
 }
 
+uint32_t Node::GetCaps() const
+{
+    // GetTypeInfo() copies several strings, caps never change for a node so ask only once
+    auto caps = m_Caps.load(std::memory_order_relaxed);
+    if (caps == UINT32_MAX)
+    {
+        caps = GetTypeInfo().m_Caps;
+        m_Caps.store(caps, std::memory_order_relaxed);
+    }
+    return caps;
+}
+
 NodeType Node::GetType() const
 {
     return GetTypeInfo().m_Type;
@@ -634,6 +903,18 @@ void Node::WasUnlinked(const Pin& receiver, const Pin& provider)
 {
 }
 
+bool Node::AcceptValueType(const Pin& receiver, PinType type) const
+{
+    auto expected = receiver.GetValueType();
+    if (expected == type || expected == PinType::Any || type == PinType::Any)
+        return true;
+    // typed array pins and the JSON array pin convert into each other
+    if ((IsTypedArrayPinType(expected) && type == PinType::Array) ||
+        (expected == PinType::Array && IsTypedArrayPinType(type)))
+        return true;
+    return false;
+}
+
 int Node::Load(const imgui_json::value& value)
 {
     if (!value.is_object())
@@ -731,9 +1012,9 @@ int Node::Load(const imgui_json::value& value)
     return BP_ERR_NONE;
 }
 
-void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
+void Node::Save(imgui_json::value& value, const IDMap& MapID)
 {
-    bool isRemap = MapID.size() > 0;
+    bool isRemap = !MapID.Empty();
     value["id"] = imgui_json::number(GetIDFromMap(m_ID, MapID)); // required
     value["name"] = imgui_json::string(m_Name); // required
     value["enabled"] = imgui_json::boolean(m_Enabled);
@@ -745,39 +1026,30 @@ void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
     value["version"] = NodeVersionToString(GetVersion());
     if (m_GroupID) value["group_id"] = imgui_json::number(GetIDFromMap(m_GroupID, MapID));
 
-    auto& inputPinsValue = value["input_pins"]; // optional
-    for (auto& pin : const_cast<Node*>(this)->GetInputPins())
+    auto save_pins = [&](span<Pin*> pins, const char * key)
     {
-        imgui_json::value pinValue;
-        pin->Save(pinValue, MapID);
-        if (isRemap && (pin->m_Flags & PIN_FLAG_EXPORTED))
+        if (pins.empty())
+            return;
+        auto& pinsValue = value[key]; // optional
+        pinsValue = imgui_json::array();
+        auto& pinsArray = pinsValue.get<imgui_json::array>();
+        pinsArray.reserve(pins.size());
+        for (auto& pin : pins)
         {
-            auto new_flags = pin->m_Flags;
-            new_flags &= ~PIN_FLAG_EXPORTED;
-            new_flags |= PIN_FLAG_PUBLICIZED;
-            pinValue["flags"] = imgui_json::number(new_flags);
+            imgui_json::value pinValue;
+            pin->Save(pinValue, MapID);
+            if (isRemap && (pin->m_Flags & PIN_FLAG_EXPORTED))
+            {
+                auto new_flags = pin->m_Flags;
+                new_flags &= ~PIN_FLAG_EXPORTED;
+                new_flags |= PIN_FLAG_PUBLICIZED;
+                pinValue["flags"] = imgui_json::number(new_flags);
+            }
+            pinsArray.push_back(std::move(pinValue));
         }
-        inputPinsValue.push_back(pinValue);
-    }
-    if (inputPinsValue.is_null())
-        value.erase("input_pins");
+    };
 
-    auto& outputPinsValue = value["output_pins"]; // optional
-    for (auto& pin : const_cast<Node*>(this)->GetOutputPins())
-    {
-        imgui_json::value pinValue;
-        pin->Save(pinValue, MapID);
-        if (isRemap && (pin->m_Flags & PIN_FLAG_EXPORTED))
-        {
-            auto new_flags = pin->m_Flags;
-            new_flags &= ~PIN_FLAG_EXPORTED;
-            new_flags |= PIN_FLAG_PUBLICIZED;
-            pinValue["flags"] = imgui_json::number(new_flags);
-        }
-        outputPinsValue.push_back(pinValue);
-    }
-    if (outputPinsValue.is_null())
-        value.erase("output_pins");
+    save_pins(GetInputPins(), "input_pins");
+    save_pins(GetOutputPins(), "output_pins");
 }
 } // namespace BluePrint
-
@@ -27,6 +27,9 @@ string PinTypeToString(PinType type)
         case PinType::Mat:      return "ImMat";
         case PinType::Array:    return "Array";
         case PinType::Custom:   return "Custom";
+        case PinType::FloatArray: return "FloatArray";
+        case PinType::Int32Array: return "Int32Array";
+        case PinType::Vec4Array:  return "ImVec4Array";
     }
 }
 
@@ -62,11 +65,196 @@ bool PinTypeFromString(string str, PinType& type)
         type = PinType::Array;
     else if (str.compare("Custom") == 0)
         type = PinType::Custom;
+    else if (str.compare("FloatArray") == 0)
+        type = PinType::FloatArray;
+    else if (str.compare("Int32Array") == 0)
+        type = PinType::Int32Array;
+    else if (str.compare("ImVec4Array") == 0)
+        type = PinType::Vec4Array;
     else
         return false;
     return true;
 }
 
+// ---------------------------
+// -------[ PinArray ]--------
+// ---------------------------
+imgui_json::array PinArrayToJson(const FloatArray& array)
+{
+    imgui_json::array json;
+    json.reserve(array.size());
+    for (auto& v : array)
+        json.push_back(imgui_json::number(v));
+    return json;
+}
+
+imgui_json::array PinArrayToJson(const Int32Array& array)
+{
+    imgui_json::array json;
+    json.reserve(array.size());
+    for (auto& v : array)
+        json.push_back(imgui_json::number(v));
+    return json;
+}
+
+imgui_json::array PinArrayToJson(const Vec4Array& array)
+{
+    imgui_json::array json;
+    json.reserve(array.size());
+    for (auto& v : array)
+        json.push_back(ed::Detail::Serialization::ToJson(v));
+    return json;
+}
+
+bool PinArrayFromJson(const imgui_json::array& json, FloatArray& array)
+{
+    FloatArray result(json.size());
+    for (size_t i = 0; i < json.size(); i++)
+    {
+        if (!json[i].is_number())
+            return false;
+        result[i] = json[i].get<imgui_json::number>();
+    }
+    array = std::move(result);
+    return true;
+}
+
+bool PinArrayFromJson(const imgui_json::array& json, Int32Array& array)
+{
+    Int32Array result(json.size());
+    for (size_t i = 0; i < json.size(); i++)
+    {
+        if (!json[i].is_number())
+            return false;
+        result[i] = json[i].get<imgui_json::number>();
+    }
+    array = std::move(result);
+    return true;
+}
+
+bool PinArrayFromJson(const imgui_json::array& json, Vec4Array& array)
+{
+    Vec4Array result(json.size());
+    for (size_t i = 0; i < json.size(); i++)
+    {
+        auto& element = json[i];
+        if (!imgui_json::GetTo<imgui_json::number>(element, "x", result[i].x) ||
+            !imgui_json::GetTo<imgui_json::number>(element, "y", result[i].y) ||
+            !imgui_json::GetTo<imgui_json::number>(element, "z", result[i].z) ||
+            !imgui_json::GetTo<imgui_json::number>(element, "w", result[i].w))
+            return false;
+    }
+    array = std::move(result);
+    return true;
+}
+
+// ---------------------------
+// -------[ PinValue ]--------
+// ---------------------------
+template <typename T> struct IsPinValueShared : std::false_type {};
+template <typename T> struct IsPinValueShared<PinValueShared<T>> : std::true_type {};
+
+uint64_t PinValue::Hash(uint64_t seed) const
+{
+    auto index = m_Value.index();
+    auto hash = fnv1a_hash_64(&index, sizeof(index), seed);
+    return std::visit([hash](auto& v) -> uint64_t
+    {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same<V, monostate>::value)
+            return hash;
+        else if constexpr (std::is_same<V, PinValueShared<std::string>>::value)
+            return fnv1a_hash_64(v.Get().data(), v.Get().size(), hash);
+        else if constexpr (std::is_same<V, PinValueShared<ImGui::ImMat>>::value)
+        {
+            // mats wrapping the same buffer are the same image, whichever holder carries them
+            auto& mat = v.Get();
+            const void* data = mat.data;
+            int shape[4] = { mat.w, mat.h, mat.c, int(mat.type) };
+            return fnv1a_hash_64(shape, sizeof(shape), fnv1a_hash_64(&data, sizeof(data), hash));
+        }
+        else if constexpr (std::is_same<V, PinValueShared<FloatArray>>::value ||
+                           std::is_same<V, PinValueShared<Int32Array>>::value ||
+                           std::is_same<V, PinValueShared<Vec4Array>>::value)
+        {
+            // unlinked array pins hand out a new handle on every GetValue, hash the contiguous data
+            auto& array = v.Get();
+            return fnv1a_hash_64(array.data(), array.size() * sizeof(*array.data()), hash);
+        }
+        else if constexpr (IsPinValueShared<V>::value)
+        {
+            auto identity = v.Identity();
+            return fnv1a_hash_64(&identity, sizeof(identity), hash);
+        }
+        else if constexpr (std::is_same<V, PinValueExPtr>::value)
+        {
+            auto identity = v.get();
+            return fnv1a_hash_64(&identity, sizeof(identity), hash);
+        }
+        else
+            return fnv1a_hash_64(&v, sizeof(v), hash);
+    }, m_Value);
+}
+
+bool PinValue::SameAs(const PinValue& other) const
+{
+    if (m_Value.index() != other.m_Value.index())
+        return false;
+    return std::visit([&other](auto& v) -> bool
+    {
+        using V = std::decay_t<decltype(v)>;
+        auto& o = get<V>(other.m_Value);
+        if constexpr (std::is_same<V, monostate>::value)
+            return true;
+        else if constexpr (std::is_same<V, PinValueShared<std::string>>::value)
+            return v.Identity() == o.Identity() || v.Get() == o.Get();
+        else if constexpr (std::is_same<V, PinValueShared<ImGui::ImMat>>::value)
+        {
+            auto& a = v.Get();
+            auto& b = o.Get();
+            return a.data == b.data && a.w == b.w && a.h == b.h && a.c == b.c && a.type == b.type && a.elempack == b.elempack;
+        }
+        else if constexpr (std::is_same<V, PinValueShared<FloatArray>>::value ||
+                           std::is_same<V, PinValueShared<Int32Array>>::value ||
+                           std::is_same<V, PinValueShared<Vec4Array>>::value)
+        {
+            auto& a = v.Get();
+            auto& b = o.Get();
+            return v.Identity() == o.Identity() ||
+                   (a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(*a.data())) == 0));
+        }
+        else if constexpr (IsPinValueShared<V>::value)
+            return v.Identity() == o.Identity();
+        else if constexpr (std::is_same<V, PinValueExPtr>::value)
+            return v.get() == o.get();
+        else if constexpr (std::is_same<V, ImVec2>::value)
+            return v.x == o.x && v.y == o.y;
+        else if constexpr (std::is_same<V, ImVec4>::value)
+            return v.x == o.x && v.y == o.y && v.z == o.z && v.w == o.w;
+        else
+            return v == o;
+    }, m_Value);
+}
+
+size_t PinValue::ByteSize() const
+{
+    return sizeof(PinValue) + std::visit([](auto& v) -> size_t
+    {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same<V, PinValueShared<std::string>>::value)
+            return v.Get().size();
+        else if constexpr (std::is_same<V, PinValueShared<ImGui::ImMat>>::value)
+            return v.Get().total() * v.Get().elemsize;
+        else if constexpr (IsPinValueShared<V>::value)
+        {
+            using T = std::decay_t<decltype(v.Get())>;
+            return v.Get().size() * sizeof(typename T::value_type);
+        }
+        else
+            return 0;
+    }, m_Value);
+}
+
 // ---------------------
 // -------[ Pin ]-------
 // ---------------------
@@ -118,6 +306,8 @@ bool Pin::LinkTo(Pin& pin)
     if (m_Link)
         Unlink();
 
+    if (m_Node->m_Blueprint)
+        m_Node->m_Blueprint->OnLinkChanged();
     m_Link = pin.m_ID;
 
     m_Node->WasLinked(*this, pin);
@@ -144,6 +334,7 @@ void Pin::Unlink()
     if (!link)
         return;
 
+    bp->OnLinkChanged();
     m_Link = 0;
 
     m_Node->WasUnlinked(*this, *link);
@@ -290,7 +481,7 @@ bool Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Pin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     value["id"] = imgui_json::number(GetIDFromMap(m_ID, MapID)); // required
     value["type"] = PinTypeToString(m_Type);
@@ -299,18 +490,23 @@ void Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
     value["flags"] = imgui_json::number(m_Flags);
     if (!m_Name.empty())
         value["name"] = m_Name;  // optional, to make data readable for humans
+    if (m_LinkFrom.empty())
+        return;
     auto& LinkFromPinsValue = value["link_from"]; // optional
+    LinkFromPinsValue = imgui_json::array();
+    auto& LinkFromPinsArray = LinkFromPinsValue.get<imgui_json::array>();
+    LinkFromPinsArray.reserve(m_LinkFrom.size());
     for (auto& pinid : m_LinkFrom)
     {
-        imgui_json::value pinValue;
         auto ID = GetIDFromMap(pinid, MapID);
         if (ID)
         {
+            imgui_json::value pinValue;
             pinValue["link_id"] = imgui_json::number(ID);
-            LinkFromPinsValue.push_back(pinValue);
+            LinkFromPinsArray.push_back(std::move(pinValue));
         }
     }
-    if (LinkFromPinsValue.is_null())
+    if (LinkFromPinsArray.empty())
         value.erase("link_from");
 }
 
@@ -351,6 +547,12 @@ PinValue Pin::GetValue() const
             return ((ArrayPin*)this)->GetValue();
         case PinType::Custom:
             return ((CustomPin*)this)->GetValue();
+        case PinType::FloatArray:
+            return ((FloatArrayPin*)this)->GetValue();
+        case PinType::Int32Array:
+            return ((Int32ArrayPin*)this)->GetValue();
+        case PinType::Vec4Array:
+            return ((Vec4ArrayPin*)this)->GetValue();
         default: break;
     }
     return PinValue{};
@@ -376,6 +578,10 @@ bool AnyPin::SetValueType(PinType type)
 
     m_InnerPin = m_Node->CreatePin(type);
 
+    // links are settled by BP::InferTypes once loading is done
+    if (m_Node->m_Blueprint && m_Node->m_Blueprint->IsLoading())
+        return true;
+
     if (auto link = GetLink())
     {
         if (link->GetValueType() != type)
@@ -426,7 +632,7 @@ bool AnyPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void AnyPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void AnyPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["vtype"] = PinTypeToString(GetValueType());
@@ -444,7 +650,7 @@ bool BoolPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void BoolPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void BoolPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = m_Value; // required
@@ -460,7 +666,7 @@ bool Int32Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Int32Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Int32Pin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = imgui_json::number(m_Value); // required
@@ -476,7 +682,7 @@ bool Int64Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Int64Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Int64Pin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = imgui_json::number(m_Value); // required
@@ -498,7 +704,7 @@ bool FloatPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void FloatPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void FloatPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     if (isnan(m_Value))
@@ -523,7 +729,7 @@ bool DoublePin::Load(const imgui_json::value& value)
     return true;
 }
 
-void DoublePin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void DoublePin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     if (isnan(m_Value))
@@ -542,7 +748,7 @@ bool StringPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void StringPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void StringPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = m_Value; // required
@@ -560,7 +766,7 @@ bool PointPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void PointPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void PointPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     // do we need load/save point value into json?
@@ -578,7 +784,7 @@ bool ArrayPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void ArrayPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void ArrayPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     // TODO::Dicky ArrayPin save
@@ -597,7 +803,7 @@ bool Vec2Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Vec2Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Vec2Pin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
@@ -619,7 +825,7 @@ bool Vec4Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Vec4Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Vec4Pin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
@@ -633,11 +839,59 @@ bool MatPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void MatPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void MatPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
 }
 
+// FloatArrayPin
+bool FloatArrayPin::Load(const imgui_json::value& value)
+{
+    if (!Pin::Load(value))
+        return false;
+    if (value.contains("array") && value["array"].is_array()) // optional
+        return PinArrayFromJson(value["array"].get<imgui_json::array>(), m_Value);
+    return true;
+}
+
+void FloatArrayPin::Save(imgui_json::value& value, const IDMap& MapID) const
+{
+    Pin::Save(value, MapID);
+    value["array"] = PinArrayToJson(m_Value);
+}
+
+// Int32ArrayPin
+bool Int32ArrayPin::Load(const imgui_json::value& value)
+{
+    if (!Pin::Load(value))
+        return false;
+    if (value.contains("array") && value["array"].is_array()) // optional
+        return PinArrayFromJson(value["array"].get<imgui_json::array>(), m_Value);
+    return true;
+}
+
+void Int32ArrayPin::Save(imgui_json::value& value, const IDMap& MapID) const
+{
+    Pin::Save(value, MapID);
+    value["array"] = PinArrayToJson(m_Value);
+}
+
+// Vec4ArrayPin
+bool Vec4ArrayPin::Load(const imgui_json::value& value)
+{
+    if (!Pin::Load(value))
+        return false;
+    if (value.contains("array") && value["array"].is_array()) // optional
+        return PinArrayFromJson(value["array"].get<imgui_json::array>(), m_Value);
+    return true;
+}
+
+void Vec4ArrayPin::Save(imgui_json::value& value, const IDMap& MapID) const
+{
+    Pin::Save(value, MapID);
+    value["array"] = PinArrayToJson(m_Value);
+}
+
 // CustomPin
 void CustomPin::InitPinEx()
 {
@@ -651,21 +905,29 @@ void CustomPin::InitPinEx()
 
 bool CustomPin::SyncValue()
 {
-    if (m_Link) 
+    if (!m_Link)
+        return false;
+
+    // find the pin which really provides the value, then share its snapshot,
+    // no copy of the payload and no lock on the way
+    auto bp = m_Node->m_Blueprint;
+    const CustomPin* provider = this;
+    while (provider->m_Link)
     {
-        auto bp = m_Node->m_Blueprint;
-        CustomPin* inPin = static_cast<CustomPin*>(GetLink(bp));
-        inPin->SyncValue();
-        inPin->m_DataAccessLock.lock();
-        PinValue pinVal = inPin->m_pPinEx->GetCustomPinValue();
-        inPin->m_DataAccessLock.unlock();
-        SetValue(pinVal);
-        return true;
+        auto link = provider->GetLink(bp);
+        if (!link || link->m_Type != PinType::Custom || link == this)
+            break;
+        provider = static_cast<const CustomPin*>(link);
     }
-    return false;
+    if (provider == this || !provider->m_pPinEx)
+        return false;
+    auto snapshot = provider->m_pPinEx->LoadPinValueEx();
+    if (snapshot != m_pPinEx->LoadPinValueEx())
+        m_pPinEx->PublishPinValueEx(std::move(snapshot));
+    return true;
 }
 
-void CustomPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void CustomPin::Save(imgui_json::value& value, const IDMap& MapID) const
 {
     Pin::Save(value, MapID);
     value["extype_name"] = m_ExTypeName;
@@ -708,58 +970,79 @@ LinkQueryResult CustomPin::CanLinkTo(const Pin& pin) const
 
 PinExRegistry::~PinExRegistry()
 {
-    if (m_dll_handle)
-        dlclose(m_dll_handle);
+    for (auto handle : m_ModuleHandles)
+        dlclose(handle);
+    m_ModuleHandles.clear();
 }
 
 const PinTypeEx* PinExRegistry::RegisterPinEx(std::string module_path)
 {
-    m_dll_handle = dlopen(module_path.c_str(), RTLD_LAZY);
-	if (!m_dll_handle) {
+    auto module = OpenPinExModule(module_path);
+    return RegisterPinExModule(module);
+}
+
+PinExRegistry::PinExModule PinExRegistry::OpenPinExModule(std::string module_path)
+{
+    PinExModule module;
+    module.m_Path = module_path;
+    void* handle = dlopen(module_path.c_str(), RTLD_LAZY);
+	if (!handle) {
 		std::cerr << "Failed to open library: " << dlerror() << std::endl;
-		return nullptr;
+		return module;
 	}
 
 	// Reset errors
 	dlerror();
 
-	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(m_dll_handle, "GetPinExModuleInfo");
+	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(handle, "GetPinExModuleInfo");
 	const char* err = dlerror();
 	if (err) {
 		std::cerr << "Failed to load version symbol: " << err << std::endl;
-		dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
-		return nullptr;
+		dlclose(handle);
+		return module;
 	}
 
     const PinExModuleInfo* pModInfo = pfnGetPinExModuleInfo();
     if (pModInfo == nullptr) {
         std::cerr << "PinExModulueInfo is NULL from '" << module_path << "'!" << std::endl;
-        dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
-        return nullptr;
+        dlclose(handle);
+        return module;
     }
 
+    module.m_Handle = handle;
+    module.m_Info = pModInfo;
+    return module;
+}
+
+const PinTypeEx* PinExRegistry::RegisterPinExModule(PinExModule& module)
+{
+    if (!module.m_Handle || !module.m_Info)
+        return nullptr;
+    const PinExModuleInfo* pModInfo = module.m_Info;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
     for (auto pInfo : m_TypeInfos) {
         if (pInfo->m_TypeEx == pModInfo->m_TypeEx) {
-            std::cerr << "Conflict PinTypeEx '" << pModInfo->m_TypeEx.GetName() << "', FAILED to load PinEx from '" << module_path << "'!" << std::endl;
-            dlclose(m_dll_handle);
-            m_dll_handle = nullptr;
+            std::cerr << "Conflict PinTypeEx '" << pModInfo->m_TypeEx.GetName() << "', FAILED to load PinEx from '" << module.m_Path << "'!" << std::endl;
+            dlclose(module.m_Handle);
+            module.m_Handle = nullptr;
             return nullptr;
         }
     }
 
+    m_ModuleHandles.push_back(module.m_Handle);
+    module.m_Handle = nullptr;
     m_TypeInfos.push_back(pModInfo);
+    m_TypeIndex.emplace(pModInfo->m_TypeEx.GetName(), pModInfo);
     return &pModInfo->m_TypeEx;
 }
 
-PinEx* PinExRegistry::Create(std::string typeName)
+PinEx* PinExRegistry::Create(const std::string& typeName)
 {
-    for (auto typeInfo : m_TypeInfos) {
-        if (typeInfo->m_TypeEx.GetName() == typeName) {
-            return typeInfo->m_CreatorFn();
-        }
-    }
-    return nullptr;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_TypeIndex.find(typeName);
+    if (it == m_TypeIndex.end())
+        return nullptr;
+    return it->second->m_CreatorFn();
 }
 }
@@ -307,6 +307,7 @@ void NodeSettingDialog::Show(BluePrintUI& UI)
             {
                 UI.File_MarkModified();
                 ed::SetNodeChanged(node->m_ID);
+                UI.m_Document->m_Blueprint.MarkNodeDirty(*node);
             }
             ImGui::CloseCurrentPopup();
             if (UI.m_CallBacks.BluePrintOnChanged)
@@ -490,11 +491,54 @@ int BluePrintUI::CheckPlugins(const std::vector<std::string>& pluginPaths)
     return plugin_number;
 }
 
-void BluePrintUI::LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count)
+// Open every module on a small worker pool, dlopen on network storage is I/O bound.
+// Results keep input order, so registration stays deterministic. Progress is
+// published by the calling thread while it waits.
+template <typename Module, typename Open>
+static std::vector<Module> OpenPluginModules(const std::vector<std::string>& paths, Open open, int& current_index, float& loading_percentage, int expect_count)
+{
+    std::vector<Module> modules(paths.size());
+    std::atomic<size_t> next {0};
+    std::atomic<int> opened {0};
+    auto worker = [&]()
+    {
+        size_t i;
+        while ((i = next++) < paths.size())
+        {
+            modules[i] = open(paths[i]);
+            opened ++;
+        }
+    };
+    size_t thread_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), paths.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++)
+        threads.emplace_back(worker);
+    int base_index = current_index;
+    while (opened < (int)paths.size())
+    {
+        current_index = base_index + opened;
+        if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
+        ImGui::sleep(0.005f);
+    }
+    for (auto& thread : threads)
+        thread.join();
+    current_index = base_index + (int)paths.size();
+    if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
+    return modules;
+}
+
+void BluePrintUI::LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count, std::string manifest_path)
 {
-    // load dynamic node
     auto nodeRegistry = BP::GetNodeRegistry();
+    auto pinexRegistry = BP::GetPinExRegistry();
     current_index = 0;
+    nodeRegistry->BeginRegistration();
+    // node plugins listed in an up-to-date manifest are registered without being opened
+    bool manifest_valid = !manifest_path.empty() && nodeRegistry->LoadManifest(manifest_path);
+    bool manifest_dirty = !manifest_path.empty() && !manifest_valid;
+
+    // discover all plugins first, merged order is by path whatever the directory walk order
+    std::vector<std::string> node_paths, pinex_paths;
     for (auto& plugin_path : pluginPaths)
     {
         std::vector<std::string> plugins, plugin_names;
@@ -502,53 +546,70 @@ void BluePrintUI::LoadPlugins(const std::vector<std::string>& pluginPaths, int&
         std::vector<std::string> pin_filter = {"pin"};
         if (DIR_Iterate(plugin_path, plugins, plugin_names, node_filter, false) == 0)
         {
-            LOGI("Load Extra Node %s", plugin_real_path.c_str());
-            for (auto node_path : plugins)
+            LOGI("Load Extra Node %s", plugin_path.c_str());
+            for (auto& node_path : plugins)
             {
-                current_index ++;
-                if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
-                auto nodetypeid = nodeRegistry->RegisterNodeType(node_path);
-                if (nodetypeid == 0)
+                if (manifest_valid && nodeRegistry->HasPlugin(node_path))
                 {
-                    LOGE("Load Extra Node Failed %s", node_path.c_str());
+                    current_index ++;
                     continue;
                 }
-                auto nodeinfo = nodeRegistry->GetTypeInfo(nodetypeid);
-                if (!nodeinfo)
-                {
-                    LOGE("Load Extra Node Failed %s", node_path.c_str());
-                    continue;
-                }
-                LOGI("Load Extra Node %s(%d.%d.%d.%d)", nodeinfo->m_NodeTypeName.c_str(),
-                                                        VERSION_MAJOR(nodeinfo->m_Version), 
-                                                        VERSION_MINOR(nodeinfo->m_Version), 
-                                                        VERSION_PATCH(nodeinfo->m_Version), 
-                                                        VERSION_BUILT(nodeinfo->m_Version));
-                current_message = nodeinfo->m_Name;
-                std::cout << "Successfully load extra node:" << current_message << std::endl;
+                node_paths.push_back(node_path);
             }
         }
-
-        // load dynamic pin
-        auto pinexRegistry = BP::GetPinExRegistry();
         plugins.clear(); plugin_names.clear();
         if (DIR_Iterate(plugin_path, plugins, plugin_names, pin_filter, false) == 0)
         {
-            current_index ++;
-            if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
-            LOGI("Load Extra PinEx %s", plugin_real_path.c_str());
-            for (auto pinex_path : plugins)
-            {
-                auto pPinexType = pinexRegistry->RegisterPinEx(pinex_path);
-                if (pPinexType == nullptr) {
-                    LOGE("FAILED to load PinEx from '%s'!", pinex_path.c_str());
-                    continue;
-                }
-                LOGI("Successfully loaded PinEx from '%s'!", pinex_path.c_str());
-                current_message = pPinexType->GetName();
-            }
+            LOGI("Load Extra PinEx %s", plugin_path.c_str());
+            pinex_paths.insert(pinex_paths.end(), plugins.begin(), plugins.end());
+        }
+    }
+    std::sort(node_paths.begin(), node_paths.end());
+    std::sort(pinex_paths.begin(), pinex_paths.end());
+    if (!node_paths.empty() && !manifest_path.empty())
+        manifest_dirty = true;
+
+    // load dynamic node
+    auto node_modules = OpenPluginModules<NodeRegistry::NodeModule>(node_paths, &NodeRegistry::OpenNodeModule, current_index, loading_percentage, expect_count);
+    for (auto& module : node_modules)
+    {
+        auto nodetypeid = nodeRegistry->RegisterNodeModule(module);
+        if (nodetypeid == 0)
+        {
+            LOGE("Load Extra Node Failed %s", module.m_Path.c_str());
+            continue;
+        }
+        auto nodeinfo = nodeRegistry->GetTypeInfo(nodetypeid);
+        if (!nodeinfo)
+        {
+            LOGE("Load Extra Node Failed %s", module.m_Path.c_str());
+            continue;
+        }
+        LOGI("Load Extra Node %s(%d.%d.%d.%d)", nodeinfo->m_NodeTypeName.c_str(),
+                                                VERSION_MAJOR(nodeinfo->m_Version), 
+                                                VERSION_MINOR(nodeinfo->m_Version), 
+                                                VERSION_PATCH(nodeinfo->m_Version), 
+                                                VERSION_BUILT(nodeinfo->m_Version));
+        current_message = nodeinfo->m_Name;
+        std::cout << "Successfully load extra node:" << current_message << std::endl;
+    }
+
+    // load dynamic pin
+    auto pinex_modules = OpenPluginModules<PinExRegistry::PinExModule>(pinex_paths, &PinExRegistry::OpenPinExModule, current_index, loading_percentage, expect_count);
+    for (auto& module : pinex_modules)
+    {
+        auto pPinexType = pinexRegistry->RegisterPinExModule(module);
+        if (pPinexType == nullptr) {
+            LOGE("FAILED to load PinEx from '%s'!", module.m_Path.c_str());
+            continue;
         }
+        LOGI("Successfully loaded PinEx from '%s'!", module.m_Path.c_str());
+        current_message = pPinexType->GetName();
     }
+
+    nodeRegistry->EndRegistration();
+    if (manifest_dirty)
+        nodeRegistry->SaveManifest(manifest_path);
 }
 
 BluePrintUI::BluePrintUI()
@@ -591,6 +652,7 @@ void BluePrintUI::Initialize(const char * bp_file)
     ed::SetCurrentEditor(m_Editor);
     m_Document = make_unique<BluePrint::Document>();
     m_Document->m_UserData = this;
+    m_Document->SetAutoSave(true);  // writes <path>.autosave once the document has a path
 
     if (bp_file)
     {
@@ -775,6 +837,7 @@ bool BluePrintUI::Frame(bool child_window, bool show_node, bool bp_enabled, uint
     bool done = false;
     if (!m_Editor || !m_Document || ReadyToQuit)
         return true;
+    m_Document->UpdateAutoSave();
     auto& io = ImGui::GetIO();
     bool multiviewport = io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable;
     const ImGuiViewport* viewport = ImGui::GetMainViewport();
@@ -1117,6 +1180,7 @@ float BluePrintUI::DrawNodeToolBar(Node *node, Node **need_clone_node)
             if (node->m_Enabled) LOGI("[HandleNodeToolBar] Enable for %" PRI_node, FMT_node(node));
             else                 LOGI("[HandleNodeToolBar] Disable for %" PRI_node, FMT_node(node));
             ed::SetNodeChanged(node->m_ID);
+            m_Document->m_Blueprint.MarkNodeDirty(*node);
             if (m_CallBacks.BluePrintOnChanged)
             {
                 m_CallBacks.BluePrintOnChanged(BP_CB_PARAM_CHANGED, m_Document->m_Name, m_UserHandle);
@@ -1717,6 +1781,7 @@ void BluePrintUI::DrawNodes()
             if (node->DrawCustomLayout(ImGui::GetCurrentContext(), zoom, origin))
             {
                 ed::SetNodeChanged(node->m_ID);
+                m_Document->m_Blueprint.MarkNodeDirty(*node);
                 if (m_CallBacks.BluePrintOnChanged)
                 {
                     auto callback_ret = m_CallBacks.BluePrintOnChanged(BP_CB_PARAM_CHANGED, m_Document->m_Name, m_UserHandle);
@@ -3297,6 +3362,7 @@ bool BluePrintUI::File_SaveAsEx(std::string path)
 {
     if (!File_IsOpen())
         return true;
+    // explicit saves stay synchronous, the document is only marked clean once the write succeeded
     if (!m_Document->Save(path))
     {
         LOGE("Failed to save blueprint to file \"%" PRI_sv "\".", FMT_sv(path));
@@ -3623,6 +3689,17 @@ bool BluePrintUI::Blueprint_SetFilter(const std::string name, const PinValue& va
     return false;
 }
 
+bool BluePrintUI::Blueprint_MarkNodeDirty(ID_TYPE id)
+{
+    if (!Blueprint_IsValid())
+        return false;
+    auto node = m_Document->m_Blueprint.FindNode(id);
+    if (!node)
+        return false;
+    m_Document->m_Blueprint.MarkNodeDirty(*node);
+    return true;
+}
+
 bool BluePrintUI::Blueprint_RunFilter(ImGui::ImMat& input, ImGui::ImMat& output, int64_t current, int64_t duration, bool bypass_bg_node)
 {
     if (!Blueprint_IsValid())
@@ -4616,6 +4693,7 @@ void BluePrintUI::ShowSettingPanel(bool* show)
                 {
                     File_MarkModified();
                     ed::SetNodeChanged(node->m_ID);
+                    m_Document->m_Blueprint.MarkNodeDirty(*node);
                     if (m_CallBacks.BluePrintOnChanged)
                     {
                         m_CallBacks.BluePrintOnChanged(BP_CB_SETTING_CHANGED, m_Document->m_Name, m_UserHandle);
@@ -35,17 +35,10 @@ std::string IDToHexString(const ID_TYPE i)
     return s.str();
 }
 
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID)
+ID_TYPE GetIDFromMap(ID_TYPE ID, const IDMap& MapID)
 {
-    if (MapID.size() > 0)
-    {
-        std::map<ID_TYPE, ID_TYPE>::iterator it;
-        it = MapID.find(ID);
-        if (it == MapID.end())
-            return 0;
-        else
-            return it->second;
-    }
+    if (!MapID.Empty())
+        return MapID.Get(ID);
     return ID;
 }
 
@@ -69,6 +62,9 @@ IconType PinTypeToIconType(PinType pinType)
         case PinType::Mat:      return IconType::Grid;
         case PinType::Array:    return IconType::BracketSquare;
         case PinType::Custom:   return IconType::Square;
+        case PinType::FloatArray:
+        case PinType::Int32Array:
+        case PinType::Vec4Array: return IconType::BracketSquare;
     }
 
     return IconType::Circle;
@@ -94,6 +90,9 @@ ImVec4 PinTypeToColor(BluePrintUI* ui, PinType pinType)
         case PinType::Mat:      return ui->m_StyleColors[BluePrintStyleColor_PinMat];
         case PinType::Array:    return ui->m_StyleColors[BluePrintStyleColor_PinPoint];
         case PinType::Custom:   return ui->m_StyleColors[BluePrintStyleColor_PinCustom];
+        case PinType::FloatArray:
+        case PinType::Int32Array:
+        case PinType::Vec4Array: return ui->m_StyleColors[BluePrintStyleColor_PinPoint];
     }
 
     return ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
@@ -153,6 +152,15 @@ bool DrawPinValue(const PinValue& value)
             return false;
         case PinType::Custom:
             return false;
+        case PinType::FloatArray:
+            ImGui::Text("[%zu] float", value.As<FloatArray>().size());
+            return true;
+        case PinType::Int32Array:
+            ImGui::Text("[%zu] int32", value.As<Int32Array>().size());
+            return true;
+        case PinType::Vec4Array:
+            ImGui::Text("[%zu] ImVec4", value.As<Vec4Array>().size());
+            return true;
         default:
             return false;
     }
@@ -0,0 +1,192 @@
+// Runs one blueprint twice side by side, once with every runtime cache off and once with the caches
+// under test on, and reports every pin whose value differs after a run. Both copies execute the same
+// steps, so counters and other stateful nodes advance together. Nodes reading the wall clock
+// (DateTime, Timer) differ between the copies on their own and are best left out of the graph.
+//
+//   bp_cache_check <blueprint.json> [runs] [--no-fold] [--no-expr] [--no-incremental] [--no-output-cache]
+//
+// Exit code is 0 when every run matched.
+#include <imgui.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace BluePrint;
+
+static bool SameContent(const PinValue& a, const PinValue& b)
+{
+    if (a.GetType() != b.GetType())
+        return false;
+    switch (a.GetType())
+    {
+        case PinType::Any:      return true;    // empty value
+        case PinType::Bool:     return a.As<bool>() == b.As<bool>();
+        case PinType::Int32:    return a.As<int32_t>() == b.As<int32_t>();
+        case PinType::Int64:    return a.As<int64_t>() == b.As<int64_t>();
+        case PinType::Float:    return a.As<float>() == b.As<float>();
+        case PinType::Double:   return a.As<double>() == b.As<double>();
+        case PinType::String:   return a.As<std::string>() == b.As<std::string>();
+        case PinType::Mat:
+        {
+            // the copies allocate their own buffers, compare pixels
+            auto& ma = a.As<ImGui::ImMat>();
+            auto& mb = b.As<ImGui::ImMat>();
+            if (ma.w != mb.w || ma.h != mb.h || ma.c != mb.c || ma.type != mb.type || ma.elempack != mb.elempack)
+                return false;
+            if (ma.empty() || ma.device != IM_DD_CPU || mb.device != IM_DD_CPU)
+                return ma.empty() == mb.empty();
+            return memcmp(ma.data, mb.data, ma.total() * ma.elemsize) == 0;
+        }
+        case PinType::FloatArray:
+        {
+            auto& va = a.As<FloatArray>();
+            auto& vb = b.As<FloatArray>();
+            return va.size() == vb.size() && std::equal(va.begin(), va.end(), vb.begin());
+        }
+        case PinType::Int32Array:
+        {
+            auto& va = a.As<Int32Array>();
+            auto& vb = b.As<Int32Array>();
+            return va.size() == vb.size() && std::equal(va.begin(), va.end(), vb.begin());
+        }
+        case PinType::Vec4Array:
+        {
+            auto& va = a.As<Vec4Array>();
+            auto& vb = b.As<Vec4Array>();
+            return va.size() == vb.size() && std::equal(va.begin(), va.end(), vb.begin(), [](const ImVec4& x, const ImVec4& y)
+            {
+                return x.x == y.x && x.y == y.y && x.z == y.z && x.w == y.w;
+            });
+        }
+        case PinType::Array:
+        {
+            imgui_json::value va = a.As<imgui_json::array>();
+            imgui_json::value vb = b.As<imgui_json::array>();
+            return va.dump() == vb.dump();
+        }
+        case PinType::Custom:   return true;    // plugin payloads have no comparison
+        default:
+            // flow, point and vectors are inline, SameAs compares them by value
+            return a.SameAs(b);
+    }
+}
+
+static Node* FindEntryPoint(BP& bp)
+{
+    for (auto node : bp.GetNodes())
+        if (node->GetType() == NodeType::EntryPoint)
+            return node;
+    return nullptr;
+}
+
+// Values the host can observe after a run: everything the run stored, and what exit points read
+static int CompareRuns(const BP& reference, const BP& cached, int run)
+{
+    int mismatches = 0;
+    auto& refContext = reference.GetContext();
+    auto& cachedContext = cached.GetContext();
+    for (auto refNode : reference.GetNodes())
+    {
+        auto node = cached.FindNode(refNode->m_ID);
+        if (!node)
+            continue;
+        bool isExit = refNode->GetType() == NodeType::ExitPoint;
+        auto pins = isExit ? const_cast<Node*>(refNode)->GetInputPins() : const_cast<Node*>(refNode)->GetOutputPins();
+        for (auto refPin : pins)
+        {
+            if (refPin->GetType() == PinType::Flow)
+                continue;
+            auto pin = cached.FindPin(refPin->m_ID);
+            if (!pin)
+                continue;
+            PinValue a, b;
+            if (isExit)
+            {
+                a = refContext.GetPinValue(*refPin);
+                b = cachedContext.GetPinValue(*pin);
+            }
+            else
+            {
+                auto refValue = refContext.GetPinValueRef(*refPin);
+                auto value = cachedContext.GetPinValueRef(*pin);
+                if (!refValue || !value)
+                    continue; // not stored by this run, evaluated on demand
+                a = *refValue;
+                b = *value;
+            }
+            if (!SameContent(a, b))
+            {
+                fprintf(stderr, "run %d: %s.%s differs\n", run, refNode->m_Name.c_str(), refPin->m_Name.c_str());
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <blueprint.json> [runs] [--no-fold] [--no-expr] [--no-incremental] [--no-output-cache]\n", argv[0]);
+        return 2;
+    }
+    int runs = 8;
+    bool fold = true, expr = true, incremental = true, output_cache = true;
+    for (int i = 2; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--no-fold"))                  fold = false;
+        else if (!strcmp(argv[i], "--no-expr"))             expr = false;
+        else if (!strcmp(argv[i], "--no-incremental"))      incremental = false;
+        else if (!strcmp(argv[i], "--no-output-cache"))     output_cache = false;
+        else runs = atoi(argv[i]);
+    }
+
+    ImGui::CreateContext();
+    BP reference, cached;
+    if (reference.Load(std::string(argv[1])) != BP_ERR_NONE || cached.Load(std::string(argv[1])) != BP_ERR_NONE)
+    {
+        fprintf(stderr, "failed to load %s\n", argv[1]);
+        return 2;
+    }
+    reference.SetConstantFolding(false);
+    reference.SetExprCompile(false);
+    reference.SetIncremental(false);
+    reference.SetOutputCache(false);
+    cached.SetConstantFolding(fold);
+    cached.SetExprCompile(expr);
+    cached.SetIncremental(incremental);
+    cached.SetOutputCache(output_cache);
+
+    auto refEntry = FindEntryPoint(reference);
+    auto entry = FindEntryPoint(cached);
+    if (!refEntry || !entry)
+    {
+        fprintf(stderr, "no entry point in %s\n", argv[1]);
+        return 2;
+    }
+
+    int mismatches = 0;
+    for (int run = 0; run < runs; run++)
+    {
+        auto refResult = reference.Run(*refEntry);
+        auto result = cached.Run(*entry);
+        if (refResult != result)
+        {
+            fprintf(stderr, "run %d: result %d, expected %d\n", run, int(result), int(refResult));
+            mismatches++;
+        }
+        mismatches += CompareRuns(reference, cached, run);
+    }
+    auto stats = cached.GetOutputCacheStats();
+    printf("%d runs, %d mismatches, output cache %u hits %u misses\n", runs, mismatches, (unsigned)stats.m_Hits, (unsigned)stats.m_Misses);
+
+    reference.Clear();
+    cached.Clear();
+    ImGui::DestroyContext();
+    return mismatches ? 1 : 0;
+}
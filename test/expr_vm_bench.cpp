@@ -0,0 +1,130 @@
+// Cost of pulling the result of a large expression graph, through the expression VM and through
+// the per-node EvaluatePin path. The graph is a chain of Add and Mul float nodes, each reading
+// the previous result and a constant of its own, with the first input changed every round so
+// nothing can be folded. Both paths must produce the same value.
+//
+//   bp_expr_vm_bench [nodes] [rounds]
+//
+// Exit code is 0 when both paths agreed on every round.
+#include <imgui.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <SystemNode/AdditionNode.h>
+#include <SystemNode/MultiplicationNode.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace BluePrint;
+
+struct Chain
+{
+    std::vector<Pin*>   m_Constants;    // B input of every node
+    Pin*                m_Input {nullptr};
+    Pin*                m_Output {nullptr};
+};
+
+static bool BuildChain(BP& bp, int count, Chain& chain)
+{
+    Pin* previous = nullptr;
+    for (int i = 0; i < count; i++)
+    {
+        bool add = i % 2 == 0;
+        auto node = bp.CreateNode(add ? AddNode::GetStaticTypeInfo().m_ID : MulNode::GetStaticTypeInfo().m_ID);
+        if (!node)
+            return false;
+        Pin *a, *b, *result;
+        if (add)
+        {
+            auto n = static_cast<AddNode*>(node);
+            n->SetType(PinType::Float);
+            a = &n->m_A; b = &n->m_B; result = &n->m_Result;
+        }
+        else
+        {
+            auto n = static_cast<MulNode*>(node);
+            n->SetType(PinType::Float);
+            a = &n->m_A; b = &n->m_B; result = &n->m_Result;
+        }
+        if (previous && !a->LinkTo(*previous))
+            return false;
+        if (!previous)
+            chain.m_Input = a;
+        chain.m_Constants.push_back(b);
+        previous = result;
+    }
+    chain.m_Output = previous;
+    return previous != nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    int count  = argc > 1 ? atoi(argv[1]) : 1000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 1000;
+    if (count <= 0 || rounds <= 0)
+    {
+        fprintf(stderr, "usage: %s [nodes] [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    ImGui::CreateContext();
+    BP bp;
+    Chain chain;
+    if (!BuildChain(bp, count, chain))
+    {
+        fprintf(stderr, "failed to build a chain of %d nodes\n", count);
+        return 2;
+    }
+    bp.SetConstantFolding(false);
+    if (bp.InferTypes() != BP_ERR_NONE)
+    {
+        fprintf(stderr, "chain did not type check\n");
+        return 2;
+    }
+
+    // add small steps, multiply by values close to 1, so the result stays in float range
+    Context context;
+    for (size_t i = 0; i < chain.m_Constants.size(); i++)
+        context.SetPinValue(*chain.m_Constants[i], PinValue(i % 2 == 0 ? float(i % 7 + 1) : 1.0f + float(i % 5) * 0.0001f));
+
+    std::vector<float> vm(rounds), pin(rounds);
+    bp.SetExprCompile(true);
+    context.SetPinValue(*chain.m_Input, PinValue(0.0f));
+    context.GetPinValue(*chain.m_Output);   // compile outside the timed loop
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        context.SetPinValue(*chain.m_Input, PinValue(float(r)));
+        auto value = context.GetPinValue(*chain.m_Output);
+        vm[r] = value.GetType() == PinType::Float ? value.As<float>() : NAN;
+    }
+    auto middle = std::chrono::steady_clock::now();
+    bp.SetExprCompile(false);
+    for (int r = 0; r < rounds; r++)
+    {
+        context.SetPinValue(*chain.m_Input, PinValue(float(r)));
+        auto value = context.GetPinValue(*chain.m_Output);
+        pin[r] = value.GetType() == PinType::Float ? value.As<float>() : NAN;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    int mismatches = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        if (!(std::fabs(vm[r] - pin[r]) <= 1e-5f * std::fmax(1.0f, std::fabs(pin[r]))))
+            mismatches++;
+    }
+    double vm_us = std::chrono::duration<double, std::micro>(middle - start).count() / rounds;
+    double pin_us = std::chrono::duration<double, std::micro>(end - middle).count() / rounds;
+    printf("%d nodes, %d rounds\n", count, rounds);
+    printf("  expression VM : %10.2f us per evaluation\n", vm_us);
+    printf("  EvaluatePin   : %10.2f us per evaluation   x%.2f\n", pin_us, vm_us > 0 ? pin_us / vm_us : 0.0);
+    if (mismatches)
+        printf("%d rounds differ between the two paths\n", mismatches);
+
+    bp.Clear();
+    ImGui::DestroyContext();
+    return mismatches ? 1 : 0;
+}
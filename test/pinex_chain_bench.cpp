@@ -0,0 +1,82 @@
+// Cost of passing a custom (PinValueEx) value down a chain of nodes. Each hop reads the value
+// the previous node stored and stores it for the next one, like Context::GetPinValue and
+// SetPinValue do with their value map. "copy" builds every stored PinValue from the raw
+// PinValueEx pointer, which clones the wrapper the way every PinValue copy did before custom
+// values were shared. "shared" copies the PinValue, a reference count increment.
+//
+//   bp_pinex_chain_bench [nodes] [rounds]
+//
+// Exit code is 0 when both chains delivered the payload unchanged.
+#include <imgui.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+using namespace BluePrint;
+
+using Payload = std::vector<float>;
+
+template <typename F>
+static double Nanoseconds(int rounds, int nodes, F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ((double)rounds * nodes);
+}
+
+static bool Delivered(const PinValue& value, const Payload* payload)
+{
+    if (value.GetType() != PinType::Custom)
+        return false;
+    auto& valex = value.As<PinValueExPtr>();
+    return valex && valex->GetVoidPtr() == payload;
+}
+
+int main(int argc, char** argv)
+{
+    int nodes  = argc > 1 ? atoi(argv[1]) : 100;
+    int rounds = argc > 2 ? atoi(argv[2]) : 100000;
+    if (nodes <= 0 || rounds <= 0)
+    {
+        fprintf(stderr, "usage: %s [nodes] [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    auto payload = std::make_shared<Payload>(1920 * 4, 1.0f);
+    PinValueExPtr source = std::make_shared<PinValueExImpl<Payload>>(payload);
+
+    // output pin ID -> value, like Context::m_Values
+    std::unordered_map<ID_TYPE, PinValue> values;
+    values.reserve(nodes + 1);
+
+    double copy_ns = Nanoseconds(rounds, nodes, [&]
+    {
+        values[0] = PinValue(static_cast<const PinValueEx*>(source.get()));
+        for (int i = 1; i <= nodes; i++)
+        {
+            auto& value = values[i - 1];
+            values[i] = PinValue(static_cast<const PinValueEx*>(value.As<PinValueExPtr>().get()));
+        }
+    });
+    bool ok = Delivered(values[nodes], payload.get());
+
+    double shared_ns = Nanoseconds(rounds, nodes, [&]
+    {
+        values[0] = PinValue(source);
+        for (int i = 1; i <= nodes; i++)
+            values[i] = values[i - 1];
+    });
+    ok &= Delivered(values[nodes], payload.get());
+
+    printf("%d nodes, %d rounds\n", nodes, rounds);
+    printf("  copy   %8.2f ns per hop\n", copy_ns);
+    printf("  shared %8.2f ns per hop   x%.2f\n", shared_ns, shared_ns > 0 ? copy_ns / shared_ns : 0.0);
+    if (!ok)
+        printf("payload did not arrive unchanged at the end of the chain\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Type lookups while loading a large document. The node registry gets padded with synthetic
+// plugin types, then every node type of the document is looked up by ID and by name, once
+// through the registry index and once by scanning GetTypes() the way lookups worked before the
+// index. Finally the document itself is loaded, which calls Create once per node.
+//
+//   bp_registry_load_bench [nodes] [types] [rounds]
+//
+// Exit code is 0 when every lookup found its type and the document loaded.
+#include <imgui.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <SystemNode/AdditionNode.h>
+#include <SystemNode/MultiplicationNode.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace BluePrint;
+
+static double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static const NodeTypeInfo* ScanByID(const NodeRegistry& registry, ID_TYPE id)
+{
+    for (auto type : registry.GetTypes())
+        if (type->m_ID == id)
+            return type;
+    return nullptr;
+}
+
+static const NodeTypeInfo* ScanByName(const NodeRegistry& registry, const std::string& name)
+{
+    for (auto type : registry.GetTypes())
+        if (type->m_Name == name)
+            return type;
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    int nodes  = argc > 1 ? atoi(argv[1]) : 20000;
+    int types  = argc > 2 ? atoi(argv[2]) : 1000;
+    int rounds = argc > 3 ? atoi(argv[3]) : 5;
+    if (nodes <= 0 || types < 0 || rounds <= 0)
+    {
+        fprintf(stderr, "usage: %s [nodes] [types] [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    ImGui::CreateContext();
+    auto registry = BP::GetNodeRegistry();
+    registry->BeginRegistration();
+    for (int i = 0; i < types; i++)
+    {
+        auto name = "Synthetic" + std::to_string(i);
+        auto info = std::make_shared<NodeTypeInfo>(NodeTypeIDFromName(name, "Bench"), name, name, "bench",
+                                                   VERSION_BLUEPRINT, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API,
+                                                   NodeType::External, NodeStyle::Default, "Bench", nullptr);
+        registry->RegisterNodeType(info);
+    }
+    registry->EndRegistration();
+
+    // document of Add and Mul nodes, saved the way a host would save it
+    imgui_json::value document;
+    {
+        BP bp;
+        for (int i = 0; i < nodes; i++)
+            bp.CreateNode(i % 2 ? MulNode::GetStaticTypeInfo().m_ID : AddNode::GetStaticTypeInfo().m_ID);
+        bp.Save(document);
+    }
+    std::vector<ID_TYPE> ids;
+    std::vector<std::string> names;
+    for (auto& nodeValue : document["nodes"].get<imgui_json::array>())
+    {
+        ID_TYPE id = 0;
+        imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", id);
+        ids.push_back(id);
+        auto info = registry->GetTypeInfo(id);
+        names.push_back(info ? info->m_Name : std::string());
+    }
+
+    // lookups by name create the node, the same factory call follows the scan
+    bool ok = true;
+    double id_index_ms = 0, id_scan_ms = 0, name_index_ms = 0, name_scan_ms = 0, load_ms = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (auto id : ids)
+            ok &= registry->GetTypeInfo(id) != nullptr;
+        id_index_ms += Milliseconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (auto id : ids)
+            ok &= ScanByID(*registry, id) != nullptr;
+        id_scan_ms += Milliseconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (auto& name : names)
+        {
+            auto node = registry->Create(name, nullptr);
+            ok &= node != nullptr;
+            delete node;
+        }
+        name_index_ms += Milliseconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (auto& name : names)
+        {
+            auto type = ScanByName(*registry, name);
+            auto node = type && type->m_Factory ? type->m_Factory(nullptr) : nullptr;
+            ok &= node != nullptr;
+            delete node;
+        }
+        name_scan_ms += Milliseconds(start);
+
+        BP bp;
+        start = std::chrono::steady_clock::now();
+        ok &= bp.Load(document) == BP_ERR_NONE && bp.GetNodes().size() == ids.size();
+        load_ms += Milliseconds(start);
+    }
+
+    printf("%d nodes, %d registered types, %d rounds\n", nodes, (int)registry->GetTypes().size(), rounds);
+    printf("  by id   index %10.3f ms   scan %10.3f ms\n", id_index_ms / rounds, id_scan_ms / rounds);
+    printf("  by name index %10.3f ms   scan %10.3f ms\n", name_index_ms / rounds, name_scan_ms / rounds);
+    printf("  BP::Load      %10.3f ms\n", load_ms / rounds);
+    if (!ok)
+        printf("a lookup failed or the document did not load\n");
+
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// Cost of evaluating a deep chain of arithmetic nodes, before and after the typed evaluators.
+// "switch" is how Add/Sub/Mul/Div::Calculate evaluated before, checking both operand types
+// against the node type and switching over it on every call. "typed" calls the evaluator the
+// node selects in SetType. Every link of the chain feeds the previous result and a constant
+// into the next node, for int32, float and double values, and both paths must agree.
+//
+//   bp_typed_eval_bench [depth] [rounds]
+//
+// Exit code is 0 when both paths produced the same result.
+#include <imgui.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <SystemNode/TypedEvaluator.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace BluePrint;
+using ElementWise::Op;
+
+template <typename T>
+static PinValue SwitchApply(Op op, const PinValue& aValue, const PinValue& bValue)
+{
+    switch (op)
+    {
+        case Op::Add: return aValue.As<T>() + bValue.As<T>();
+        case Op::Sub: return aValue.As<T>() - bValue.As<T>();
+        case Op::Mul: return aValue.As<T>() * bValue.As<T>();
+        case Op::Div: return ElementWise::Apply<Op::Div>(aValue.As<T>(), bValue.As<T>());
+    }
+    return {};
+}
+
+// the former per-call evaluation of the arithmetic nodes
+static PinValue SwitchCalculate(Op op, const PinValue& aValue, const PinValue& bValue, PinType type)
+{
+    if (ElementWise::IsContainerType(type))
+        return ElementWise::Calculate(op, aValue, bValue, type);
+
+    if (aValue.GetType() != type || bValue.GetType() != type)
+        return {}; // Error: Node values must be of same type
+
+    switch (type)
+    {
+        case PinType::Int32:    return SwitchApply<int32_t>(op, aValue, bValue);
+        case PinType::Int64:    return SwitchApply<int64_t>(op, aValue, bValue);
+        case PinType::Float:    return SwitchApply<float>(op, aValue, bValue);
+        case PinType::Double:   return SwitchApply<double>(op, aValue, bValue);
+        default:                break;
+    }
+    return {}; // Error: Unsupported type
+}
+
+static Typed::BinaryEvaluator SelectEvaluator(Op op, PinType type)
+{
+    switch (op)
+    {
+        case Op::Add: return Typed::SelectArithmetic<Op::Add>(type);
+        case Op::Sub: return Typed::SelectArithmetic<Op::Sub>(type);
+        case Op::Mul: return Typed::SelectArithmetic<Op::Mul>(type);
+        case Op::Div: return Typed::SelectArithmetic<Op::Div>(type);
+    }
+    return &Typed::UnsupportedBinary;
+}
+
+struct ChainNode
+{
+    Op                      m_Op;
+    PinValue                m_Constant;
+    Typed::BinaryEvaluator  m_Evaluator;    // chosen once, like SetType does
+};
+
+template <typename T>
+static bool Bench(const char* name, PinType type, int depth, int rounds)
+{
+    // add and sub of small values, mul and div by values near 1, keeps every type in range
+    const Op ops[] = { Op::Add, Op::Mul, Op::Sub, Op::Div };
+    std::vector<ChainNode> chain;
+    for (int i = 0; i < depth; i++)
+    {
+        ChainNode node;
+        node.m_Op = ops[i % 4];
+        bool scale = node.m_Op == Op::Mul || node.m_Op == Op::Div;
+        node.m_Constant = PinValue(scale ? (T)1 : (T)(i % 7 + 1));
+        node.m_Evaluator = SelectEvaluator(node.m_Op, type);
+        chain.push_back(node);
+    }
+
+    PinValue switch_result, typed_result;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        PinValue value = PinValue((T)r);
+        for (auto& node : chain)
+            value = SwitchCalculate(node.m_Op, value, node.m_Constant, type);
+        switch_result = value;
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        PinValue value = PinValue((T)r);
+        for (auto& node : chain)
+            value = node.m_Evaluator(value, node.m_Constant);
+        typed_result = value;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double switch_ns = std::chrono::duration<double, std::nano>(middle - start).count() / ((double)rounds * depth);
+    double typed_ns = std::chrono::duration<double, std::nano>(end - middle).count() / ((double)rounds * depth);
+    bool same = switch_result.GetType() == type && typed_result.GetType() == type &&
+                switch_result.As<T>() == typed_result.As<T>();
+    printf("%-6s switch %7.2f ns/node   typed %7.2f ns/node   x%.2f%s\n", name, switch_ns, typed_ns,
+           typed_ns > 0 ? switch_ns / typed_ns : 0.0, same ? "" : "   MISMATCH");
+    return same;
+}
+
+int main(int argc, char** argv)
+{
+    int depth  = argc > 1 ? atoi(argv[1]) : 1000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+    if (depth <= 0 || rounds <= 0)
+    {
+        fprintf(stderr, "usage: %s [depth] [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    printf("chain of %d nodes, %d rounds\n", depth, rounds);
+    bool ok = true;
+    ok &= Bench<int32_t>("int32", PinType::Int32, depth, rounds);
+    ok &= Bench<float>("float", PinType::Float, depth, rounds);
+    ok &= Bench<double>("double", PinType::Double, depth, rounds);
+    return ok ? 0 : 1;
+}